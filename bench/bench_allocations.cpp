@@ -0,0 +1,131 @@
+#include "alloc_counter.hpp"
+
+#include <benchmark/benchmark.h>
+#include <expected/error_message.hpp>
+#include <expected/expected.hpp>
+#include <expected/shared_error.hpp>
+
+#include <string>
+#include <utility>
+
+// Heap allocations per iteration next to the timings, so a change that starts allocating on
+// an error path shows up as a counter going from 0 rather than as noise in the time.
+
+namespace
+{
+
+struct status
+{
+    int code;
+    const char* reason;
+};
+
+void report_allocations(benchmark::State& state, const alloc_counter::scope& scope)
+{
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(scope.allocations()),
+                                                  benchmark::Counter::kAvgIterations);
+    state.counters["alloc_bytes"] = benchmark::Counter(static_cast<double>(scope.new_bytes()),
+                                                       benchmark::Counter::kAvgIterations);
+}
+
+template <class E>
+std_::expected<int, E> step(int v, const E& error)
+{
+    if (v < 0)
+    {
+        return std_::unexpected<E>(error);
+    }
+    return v + 1;
+}
+
+}  // namespace
+
+static void BM_status_chain_error(benchmark::State& state)
+{
+    const status err{5, "io"};
+    alloc_counter::scope scope;
+    for (auto _ : state)
+    {
+        auto r = step(-1, err).and_then(
+            [&err](int v)
+            {
+                return step(v, err);
+            });
+        benchmark::DoNotOptimize(r);
+    }
+    report_allocations(state, scope);
+}
+
+static void BM_string_chain_error(benchmark::State& state)
+{
+    const std::string err(48, 'e');
+    alloc_counter::scope scope;
+    for (auto _ : state)
+    {
+        auto r = step(-1, err).and_then(
+            [&err](int v)
+            {
+                return step(v, err);
+            });
+        benchmark::DoNotOptimize(r);
+    }
+    report_allocations(state, scope);
+}
+
+static void BM_string_lvalue_and_then(benchmark::State& state)
+{
+    const std::string err(48, 'e');
+    const auto failed = step(-1, err);
+    alloc_counter::scope scope;
+    for (auto _ : state)
+    {
+        // The lvalue overload has to copy the error; the chains above move it.
+        auto r = failed.and_then(
+            [&err](int v)
+            {
+                return step(v, err);
+            });
+        benchmark::DoNotOptimize(r);
+    }
+    report_allocations(state, scope);
+}
+
+static void BM_error_message_chain_error(benchmark::State& state)
+{
+    const std_::error_message err(std::string(48, 'e'));
+    alloc_counter::scope scope;
+    for (auto _ : state)
+    {
+        auto r = step(-1, err).and_then(
+            [&err](int v)
+            {
+                return step(v, err);
+            });
+        benchmark::DoNotOptimize(r);
+    }
+    report_allocations(state, scope);
+}
+
+static void BM_shared_error_chain_error(benchmark::State& state)
+{
+    const auto err = std_::make_shared_error<std::string>(48, 'e');
+    alloc_counter::scope scope;
+    for (auto _ : state)
+    {
+        auto r = step(-1, err).and_then(
+            [&err](int v)
+            {
+                return step(v, err);
+            });
+        benchmark::DoNotOptimize(r);
+    }
+    report_allocations(state, scope);
+}
+
+BENCHMARK(BM_status_chain_error);
+BENCHMARK(BM_string_chain_error);
+BENCHMARK(BM_string_lvalue_and_then);
+BENCHMARK(BM_error_message_chain_error);
+BENCHMARK(BM_shared_error_chain_error);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,240 @@
+#include "perf_counters.hpp"
+
+#include <benchmark/benchmark.h>
+#include <expected/expected.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Error handling strategies over pre-generated outcome sequences instead of a constant
+// outcome per loop. The sequences are long enough that the branch predictor cannot learn
+// them, and include bursty (Markov) patterns where failures cluster. Branch-misses are
+// reported alongside time when hardware counters are available; they cover the timed loop
+// only, not the generation of the sequence.
+
+namespace
+{
+
+constexpr std::size_t sequence_length = 1 << 16;
+
+enum pattern : std::int64_t
+{
+    bernoulli_0_1,
+    bernoulli_1,
+    bernoulli_10,
+    bernoulli_50,
+    bursty_rare,
+    bursty_frequent
+};
+
+const char* pattern_name(std::int64_t p)
+{
+    switch (p)
+    {
+    case bernoulli_0_1:
+        return "bernoulli 0.1%";
+    case bernoulli_1:
+        return "bernoulli 1%";
+    case bernoulli_10:
+        return "bernoulli 10%";
+    case bernoulli_50:
+        return "bernoulli 50%";
+    case bursty_rare:
+        return "markov ~1% in bursts of ~10";
+    default:
+        return "markov ~10% in bursts of ~5";
+    }
+}
+
+struct xorshift
+{
+    std::uint64_t s = 0x9E37'79B9'7F4A'7C15ull;
+
+    // Uniform in [0, 1'000'000).
+    std::uint32_t ppm() noexcept
+    {
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        return static_cast<std::uint32_t>(s % 1'000'000u);
+    }
+};
+
+// true = the operation fails.
+std::vector<unsigned char> make_outcomes(std::int64_t p)
+{
+    std::vector<unsigned char> out(sequence_length);
+    xorshift rng;
+
+    if (p <= bernoulli_50)
+    {
+        static const std::uint32_t rate_ppm[] = {1'000, 10'000, 100'000, 500'000};
+        const std::uint32_t rate = rate_ppm[p];
+        for (auto& o : out)
+        {
+            o = rng.ppm() < rate ? 1 : 0;
+        }
+        return out;
+    }
+
+    // Two-state chain: enter a failure burst with probability `enter`, stay in it with
+    // probability `stay`. Stationary failure rate is enter / (enter + 1 - stay).
+    const std::uint32_t enter = p == bursty_rare ? 1'000 : 22'000;
+    const std::uint32_t stay = p == bursty_rare ? 900'000 : 800'000;
+    bool failing = false;
+    for (auto& o : out)
+    {
+        failing = rng.ppm() < (failing ? stay : enter);
+        o = failing ? 1 : 0;
+    }
+    return out;
+}
+
+__attribute__((noinline)) std_::expected<int, std::string> step_expected(int v, bool fail)
+{
+    if (fail)
+    {
+        return std_::unexpected<std::string>("step failed");
+    }
+    return v + 1;
+}
+
+__attribute__((noinline)) int step_throwing(int v, bool fail)
+{
+    if (fail)
+    {
+        throw std::runtime_error("step failed");
+    }
+    return v + 1;
+}
+
+__attribute__((noinline)) std::optional<int> step_optional(int v, bool fail)
+{
+    if (fail)
+    {
+        return std::nullopt;
+    }
+    return v + 1;
+}
+
+}  // namespace
+
+class BranchPatterns : public bench::perf_counter_fixture
+{
+};
+
+BENCHMARK_DEFINE_F(BranchPatterns, expected_and_then)(benchmark::State& state)
+{
+    state.SetLabel(pattern_name(state.range(0)));
+    const auto outcomes = make_outcomes(state.range(0));
+    std::size_t i = 0;
+    bench::counted_scope counted(counters());
+    for (auto _ : state)
+    {
+        const bool fail = outcomes[i] != 0;
+        auto r = step_expected(static_cast<int>(i), fail)
+                     .and_then(
+                         [](int v)
+                         {
+                             return step_expected(v, false);
+                         })
+                     .and_then(
+                         [](int v)
+                         {
+                             return step_expected(v, false);
+                         });
+        benchmark::DoNotOptimize(r);
+        i = (i + 1) & (sequence_length - 1);
+    }
+}
+
+BENCHMARK_DEFINE_F(BranchPatterns, expected_value_or)(benchmark::State& state)
+{
+    state.SetLabel(pattern_name(state.range(0)));
+    const auto outcomes = make_outcomes(state.range(0));
+    std::size_t i = 0;
+    bench::counted_scope counted(counters());
+    for (auto _ : state)
+    {
+        int v = step_expected(static_cast<int>(i), outcomes[i] != 0).value_or(-1);
+        benchmark::DoNotOptimize(v);
+        i = (i + 1) & (sequence_length - 1);
+    }
+}
+
+BENCHMARK_DEFINE_F(BranchPatterns, exception_chain)(benchmark::State& state)
+{
+    state.SetLabel(pattern_name(state.range(0)));
+    const auto outcomes = make_outcomes(state.range(0));
+    std::size_t i = 0;
+    bench::counted_scope counted(counters());
+    for (auto _ : state)
+    {
+        int v;
+        try
+        {
+            v = step_throwing(step_throwing(step_throwing(static_cast<int>(i), outcomes[i] != 0),
+                                            false),
+                              false);
+        }
+        catch (const std::exception&)
+        {
+            v = -1;
+        }
+        benchmark::DoNotOptimize(v);
+        i = (i + 1) & (sequence_length - 1);
+    }
+}
+
+BENCHMARK_DEFINE_F(BranchPatterns, optional_chain)(benchmark::State& state)
+{
+    state.SetLabel(pattern_name(state.range(0)));
+    const auto outcomes = make_outcomes(state.range(0));
+    std::size_t i = 0;
+    bench::counted_scope counted(counters());
+    for (auto _ : state)
+    {
+        std::optional<int> r = step_optional(static_cast<int>(i), outcomes[i] != 0);
+        if (r)
+        {
+            r = step_optional(*r, false);
+        }
+        if (r)
+        {
+            r = step_optional(*r, false);
+        }
+        int v = r.value_or(-1);
+        benchmark::DoNotOptimize(v);
+        i = (i + 1) & (sequence_length - 1);
+    }
+}
+
+BENCHMARK_DEFINE_F(BranchPatterns, expected_error_construct)(benchmark::State& state)
+{
+    state.SetLabel(pattern_name(state.range(0)));
+    const auto outcomes = make_outcomes(state.range(0));
+    const std::string detail(48, 'e');
+    std::size_t i = 0;
+    bench::counted_scope counted(counters());
+    for (auto _ : state)
+    {
+        std_::expected<int, std::string> e =
+            outcomes[i] != 0 ? std_::expected<int, std::string>(std_::unexpected<std::string>(detail))
+                             : std_::expected<int, std::string>(static_cast<int>(i));
+        benchmark::DoNotOptimize(e);
+        i = (i + 1) & (sequence_length - 1);
+    }
+}
+
+BENCHMARK_REGISTER_F(BranchPatterns, expected_and_then)->DenseRange(bernoulli_0_1, bursty_frequent);
+BENCHMARK_REGISTER_F(BranchPatterns, expected_value_or)->DenseRange(bernoulli_0_1, bursty_frequent);
+BENCHMARK_REGISTER_F(BranchPatterns, exception_chain)->DenseRange(bernoulli_0_1, bursty_frequent);
+BENCHMARK_REGISTER_F(BranchPatterns, optional_chain)->DenseRange(bernoulli_0_1, bursty_frequent);
+BENCHMARK_REGISTER_F(BranchPatterns, expected_error_construct)
+    ->DenseRange(bernoulli_0_1, bursty_frequent);
+
+BENCHMARK_MAIN();
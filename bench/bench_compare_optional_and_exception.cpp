@@ -1,8 +1,10 @@
 #include <benchmark/benchmark.h>
+#include <expected/error_message.hpp>
 #include <expected/expected.hpp>
 
 #include <optional>
 #include <stdexcept>
+#include <string>
 
 
 int heavy_compute()
@@ -43,6 +45,41 @@ static void BM_expected_error(benchmark::State& state)
     }
 }
 
+static void BM_expected_error_string(benchmark::State& state)
+{
+    const std::string text(static_cast<std::size_t>(state.range(0)), 'e');
+    for (auto _ : state)
+    {
+        std_::expected<int, std::string> e = std_::unexpected<std::string>(std::string(text));
+        int v = e.value_or(-1);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+static void BM_expected_error_message(benchmark::State& state)
+{
+    const std::string text(static_cast<std::size_t>(state.range(0)), 'e');
+    for (auto _ : state)
+    {
+        std_::expected<int, std_::error_message> e =
+            std_::unexpected<std_::error_message>(std_::error_message(text));
+        int v = e.value_or(-1);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+static void BM_expected_error_message_literal(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std_::expected<int, std_::error_message> e =
+            std_::unexpected<std_::error_message>(std_::error_message::from_literal(
+                "connection reset by peer while reading body"));
+        int v = e.value_or(-1);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
 static void BM_optional_throw_error(benchmark::State& state)
 {
     for (auto _ : state)
@@ -62,5 +99,8 @@ BENCHMARK(BM_expected_success);
 BENCHMARK(BM_optional_success);
 BENCHMARK(BM_expected_error);
 BENCHMARK(BM_optional_throw_error);
+BENCHMARK(BM_expected_error_string)->Arg(16)->Arg(48)->Arg(256);
+BENCHMARK(BM_expected_error_message)->Arg(16)->Arg(48)->Arg(256);
+BENCHMARK(BM_expected_error_message_literal);
 
 BENCHMARK_MAIN();
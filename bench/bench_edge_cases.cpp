@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 #include <expected/expected.hpp>
+#include <expected/shared_error.hpp>
 
 #include <memory>
 #include <string>
@@ -45,8 +46,51 @@ static void BM_large_value_move(benchmark::State& state)
     }
 }
 
+static void BM_string_error_copy(benchmark::State& state)
+{
+    const std_::expected<int, std::string> src =
+        std_::unexpected<std::string>(std::string(static_cast<std::size_t>(state.range(0)), 'e'));
+    for (auto _ : state)
+    {
+        std_::expected<int, std::string> copy = src;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+static void BM_shared_error_copy(benchmark::State& state)
+{
+    using error = std_::shared_error<std::string>;
+    const std_::expected<int, error> src = std_::unexpected<error>(
+        std_::make_shared_error<std::string>(static_cast<std::size_t>(state.range(0)), 'e'));
+    for (auto _ : state)
+    {
+        std_::expected<int, error> copy = src;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+static void BM_local_shared_error_and_then(benchmark::State& state)
+{
+    using error = std_::shared_error<std::string, std_::local_refcount>;
+    const std_::expected<int, error> src = std_::unexpected<error>(
+        std_::make_shared_error<std::string, std_::local_refcount>(
+            static_cast<std::size_t>(state.range(0)), 'e'));
+    for (auto _ : state)
+    {
+        auto r = src.and_then(
+            [](int v)
+            {
+                return std_::expected<int, error>(v + 1);
+            });
+        benchmark::DoNotOptimize(r);
+    }
+}
+
 BENCHMARK(BM_move_only_value_success);
 BENCHMARK(BM_move_only_unexpected);
 BENCHMARK(BM_large_value_move);
+BENCHMARK(BM_string_error_copy)->RangeMultiplier(8)->Range(16, 64 << 10);
+BENCHMARK(BM_shared_error_copy)->RangeMultiplier(8)->Range(16, 64 << 10);
+BENCHMARK(BM_local_shared_error_and_then)->RangeMultiplier(8)->Range(16, 64 << 10);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include <expected/expected.hpp>
+#include <expected/hash.hpp>
+#include <expected/wire.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+// Hashing 4096 expected<int64_t, int32_t> results (1 in 8 an error): std::hash item by item,
+// hash_batch over the array of results, and hash_batch over the packed wire batch, whose value
+// and error blocks are hashed as contiguous arrays.
+
+namespace
+{
+
+using result = std_::expected<std::int64_t, std::int32_t>;
+
+const std::vector<result>& results()
+{
+    static const std::vector<result> items = []
+    {
+        std::vector<result> out;
+        std::uint64_t x = 0x9E3779B97F4A7C15ull;
+        for (int i = 0; i < 4'096; ++i)
+        {
+            x = x * 6364136223846793005ull + 1442695040888963407ull;
+            if ((x >> 61) == 0)
+            {
+                out.push_back(std_::unexpected<std::int32_t>(static_cast<std::int32_t>(x >> 40)));
+            }
+            else
+            {
+                out.push_back(static_cast<std::int64_t>(x >> 8));
+            }
+        }
+        return out;
+    }();
+    return items;
+}
+
+void BM_std_hash_per_item(benchmark::State& state)
+{
+    const std::vector<result>& items = results();
+    std::vector<std::size_t> out(items.size());
+    const std::hash<result> h;
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            out[i] = h(items[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * items.size()));
+}
+BENCHMARK(BM_std_hash_per_item);
+
+void BM_hash_batch_results(benchmark::State& state)
+{
+    const std::vector<result>& items = results();
+    std::vector<std::size_t> out(items.size());
+    for (auto _ : state)
+    {
+        std_::hash_batch(std::span<const result>(items), std::span<std::size_t>(out));
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * items.size()));
+}
+BENCHMARK(BM_hash_batch_results);
+
+void BM_hash_batch_packed(benchmark::State& state)
+{
+    const std::vector<result>& items = results();
+    const std::vector<std::byte> buffer =
+        std_::wire::encode_batch(std::span<const result>(items)).value();
+    const auto view = std_::wire::batch_view<std::int64_t, std::int32_t>::parse(buffer);
+    std::vector<std::size_t> out(items.size());
+    for (auto _ : state)
+    {
+        std_::hash_batch(*view, std::span<std::size_t>(out));
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * items.size()));
+}
+BENCHMARK(BM_hash_batch_packed);
+
+}  // namespace
+
+BENCHMARK_MAIN();
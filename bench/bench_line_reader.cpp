@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include <expected/io.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+// Line throughput over a generated local log file (LINE_READER_BENCH_MB, default 128 MiB):
+// line_reader against std::getline on an ifstream and against a memchr scan of map_file().
+// After the first run the file is in the page cache, so this measures the reader, not the
+// disk. bytes_per_second is the figure to compare.
+
+namespace
+{
+
+std::size_t file_megabytes()
+{
+    const char* mb = std::getenv("LINE_READER_BENCH_MB");
+    return mb != nullptr ? static_cast<std::size_t>(std::strtoul(mb, nullptr, 10)) : 128;
+}
+
+const std::string& log_file()
+{
+    static const std::string path = []
+    {
+        std::string p = "/tmp/std_expected_line_reader_bench.log";
+        const std::size_t target = file_megabytes() << 20;
+        std::FILE* f = std::fopen(p.c_str(), "wb");
+        std::string line;
+        std::size_t written = 0;
+        for (unsigned i = 0; written < target; ++i)
+        {
+            line = "2024-01-01T00:00:00." + std::to_string(i % 1000000)
+                   + " INFO worker-" + std::to_string(i % 64)
+                   + " request handled status=200 bytes=" + std::to_string(i * 7919u % 65536)
+                   + '\n';
+            std::fwrite(line.data(), 1, line.size(), f);
+            written += line.size();
+        }
+        std::fclose(f);
+        return p;
+    }();
+    return path;
+}
+
+void report(benchmark::State& state, std::size_t bytes, std::size_t lines)
+{
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+    state.counters["lines"] = static_cast<double>(lines);
+}
+
+void BM_line_reader(benchmark::State& state)
+{
+    const std::string& path = log_file();
+    std::size_t bytes = 0;
+    std::size_t lines = 0;
+    for (auto _ : state)
+    {
+        std_::reader_options options;
+        options.buffer_size = static_cast<std::size_t>(state.range(0)) << 10;
+        auto reader = std_::line_reader::open(path.c_str(), options);
+        lines = 0;
+        std::size_t length = 0;
+        for (auto line = reader->next(); line; line = reader->next())
+        {
+            length += line->size();
+            ++lines;
+        }
+        benchmark::DoNotOptimize(length);
+        bytes = reader->bytes_read();
+    }
+    report(state, bytes, lines);
+}
+BENCHMARK(BM_line_reader)->Arg(64)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+void BM_getline(benchmark::State& state)
+{
+    const std::string& path = log_file();
+    std::size_t bytes = 0;
+    std::size_t lines = 0;
+    for (auto _ : state)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string line;
+        lines = 0;
+        bytes = 0;
+        while (std::getline(in, line))
+        {
+            bytes += line.size() + 1;
+            ++lines;
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+    report(state, bytes, lines);
+}
+BENCHMARK(BM_getline)->Unit(benchmark::kMillisecond);
+
+void BM_mapped_memchr(benchmark::State& state)
+{
+    const std::string& path = log_file();
+    std::size_t bytes = 0;
+    std::size_t lines = 0;
+    for (auto _ : state)
+    {
+        auto mapped = std_::map_file(path);
+        const char* p = reinterpret_cast<const char*>(mapped->data());
+        const char* end = p + mapped->size();
+        lines = 0;
+        while (const void* nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p)))
+        {
+            p = static_cast<const char*>(nl) + 1;
+            ++lines;
+        }
+        bytes = mapped->size();
+    }
+    report(state, bytes, lines);
+}
+BENCHMARK(BM_mapped_memchr)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,360 @@
+#include <benchmark/benchmark.h>
+#include <expected/expected.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Every operation over a matrix of T/E shapes: payload size, trivial or not, and whether the
+// move constructor is noexcept. The argument is the failure ratio in percent. Results are
+// emitted as JSON unless --benchmark_format is given, so runs can be diffed per operation.
+
+enum class shape
+{
+    trivial,
+    nothrow_move,
+    throwing_move
+};
+
+template <std::size_t Size, shape Shape>
+struct payload;
+
+template <std::size_t Size>
+struct payload<Size, shape::trivial>
+{
+    unsigned char bytes[Size];
+
+    payload() = default;
+
+    explicit payload(int seed) noexcept
+    {
+        std::memset(bytes, seed, Size);
+    }
+};
+
+template <std::size_t Size, bool NothrowMove>
+struct managed_payload
+{
+    unsigned char bytes[Size];
+
+    explicit managed_payload(int seed) noexcept
+    {
+        std::memset(bytes, seed, Size);
+    }
+
+    managed_payload(const managed_payload& rhs) noexcept
+    {
+        std::memcpy(bytes, rhs.bytes, Size);
+        benchmark::ClobberMemory();
+    }
+
+    managed_payload(managed_payload&& rhs) noexcept(NothrowMove)
+    {
+        std::memcpy(bytes, rhs.bytes, Size);
+        benchmark::ClobberMemory();
+    }
+
+    managed_payload& operator=(const managed_payload& rhs) noexcept
+    {
+        std::memcpy(bytes, rhs.bytes, Size);
+        benchmark::ClobberMemory();
+        return *this;
+    }
+
+    managed_payload& operator=(managed_payload&& rhs) noexcept(NothrowMove)
+    {
+        std::memcpy(bytes, rhs.bytes, Size);
+        benchmark::ClobberMemory();
+        return *this;
+    }
+
+    ~managed_payload()
+    {
+        benchmark::ClobberMemory();
+    }
+};
+
+template <std::size_t Size>
+struct payload<Size, shape::nothrow_move> : managed_payload<Size, true>
+{
+    using managed_payload<Size, true>::managed_payload;
+};
+
+template <std::size_t Size>
+struct payload<Size, shape::throwing_move> : managed_payload<Size, false>
+{
+    using managed_payload<Size, false>::managed_payload;
+};
+
+static_assert(std::is_trivially_copyable<payload<64, shape::trivial>>::value, "trivial shape");
+static_assert(!std::is_nothrow_move_constructible<payload<64, shape::throwing_move>>::value,
+              "throwing shape");
+
+namespace
+{
+
+constexpr std::size_t pool_size = 1'024;
+
+// Deterministic failure pattern, so every shape sees the same sequence for a given ratio.
+std::vector<bool> failure_pattern(std::int64_t percent)
+{
+    std::vector<bool> fails(pool_size);
+    std::uint32_t x = 2'463'534'242u;
+    for (std::size_t i = 0; i < pool_size; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        fails[i] = static_cast<std::int64_t>(x % 100u) < percent;
+    }
+    return fails;
+}
+
+template <class T, class E>
+std::vector<std_::expected<T, E>> make_pool(const benchmark::State& state)
+{
+    std::vector<std_::expected<T, E>> pool;
+    pool.reserve(pool_size);
+    for (bool fail : failure_pattern(state.range(0)))
+    {
+        if (fail)
+        {
+            pool.emplace_back(std_::unexpected<E>(E(2)));
+        }
+        else
+        {
+            pool.emplace_back(T(1));
+        }
+    }
+    return pool;
+}
+
+}  // namespace
+
+template <class T, class E>
+static void BM_construct(benchmark::State& state)
+{
+    const std::vector<bool> fails = failure_pattern(state.range(0));
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        if (fails[i])
+        {
+            std_::expected<T, E> e(std_::unexpected<E>(E(2)));
+            benchmark::DoNotOptimize(e);
+        }
+        else
+        {
+            std_::expected<T, E> e(T(1));
+            benchmark::DoNotOptimize(e);
+        }
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class T, class E>
+static void BM_copy(benchmark::State& state)
+{
+    const auto pool = make_pool<T, E>(state);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        std_::expected<T, E> copy(pool[i]);
+        benchmark::DoNotOptimize(copy);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class T, class E>
+static void BM_move(benchmark::State& state)
+{
+    auto pool = make_pool<T, E>(state);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        std_::expected<T, E> moved(std::move(pool[i]));
+        benchmark::DoNotOptimize(moved);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class T, class E>
+static void BM_assign(benchmark::State& state)
+{
+    const auto pool = make_pool<T, E>(state);
+    std_::expected<T, E> target(T(0));
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        target = pool[i];
+        benchmark::DoNotOptimize(target);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class T, class E>
+static void BM_swap(benchmark::State& state)
+{
+    auto pool = make_pool<T, E>(state);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        pool[i].swap(pool[(i + 1) % pool_size]);
+        benchmark::DoNotOptimize(pool[i]);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class T, class E>
+static void BM_value_or(benchmark::State& state)
+{
+    const auto pool = make_pool<T, E>(state);
+    const T fallback(3);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        T v = pool[i].value_or(fallback);
+        benchmark::DoNotOptimize(v);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class T, class E>
+static void BM_and_then(benchmark::State& state)
+{
+    const auto pool = make_pool<T, E>(state);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto r = pool[i].and_then(
+            [](const T& v)
+            {
+                return std_::expected<T, E>(v);
+            });
+        benchmark::DoNotOptimize(r);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class T, class E>
+static void BM_transform(benchmark::State& state)
+{
+    const auto pool = make_pool<T, E>(state);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto r = pool[i].transform(
+            [](const T& v)
+            {
+                T out(v);
+                out.bytes[0] ^= 1;
+                return out;
+            });
+        benchmark::DoNotOptimize(r);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class T, class E>
+static void BM_or_else(benchmark::State& state)
+{
+    const auto pool = make_pool<T, E>(state);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto r = pool[i].or_else(
+            [](const E&)
+            {
+                return std_::expected<T, E>(T(4));
+            });
+        benchmark::DoNotOptimize(r);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class T, class E>
+static void BM_transform_error(benchmark::State& state)
+{
+    const auto pool = make_pool<T, E>(state);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto r = pool[i].transform_error(
+            [](const E& e)
+            {
+                E out(e);
+                out.bytes[0] ^= 1;
+                return out;
+            });
+        benchmark::DoNotOptimize(r);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class T, class E>
+void register_ops(const std::string& tag)
+{
+    const auto add = [&tag](const char* op, void (*fn)(benchmark::State&))
+    {
+        benchmark::RegisterBenchmark((std::string(op) + "/" + tag).c_str(), fn)
+            ->ArgName("fail_pct")
+            ->Arg(0)
+            ->Arg(1)
+            ->Arg(10)
+            ->Arg(50);
+    };
+    add("construct", BM_construct<T, E>);
+    add("copy", BM_copy<T, E>);
+    add("move", BM_move<T, E>);
+    add("assign", BM_assign<T, E>);
+    add("swap", BM_swap<T, E>);
+    add("value_or", BM_value_or<T, E>);
+    add("and_then", BM_and_then<T, E>);
+    add("transform", BM_transform<T, E>);
+    add("or_else", BM_or_else<T, E>);
+    add("transform_error", BM_transform_error<T, E>);
+}
+
+template <shape Shape>
+void register_shape(const std::string& name)
+{
+    register_ops<payload<1, Shape>, payload<1, Shape>>(name + "/T1/E1");
+    register_ops<payload<8, Shape>, payload<8, Shape>>(name + "/T8/E8");
+    register_ops<payload<64, Shape>, payload<64, Shape>>(name + "/T64/E64");
+    register_ops<payload<512, Shape>, payload<512, Shape>>(name + "/T512/E512");
+    register_ops<payload<8, Shape>, payload<512, Shape>>(name + "/T8/E512");
+    register_ops<payload<512, Shape>, payload<8, Shape>>(name + "/T512/E8");
+}
+
+int main(int argc, char** argv)
+{
+    register_shape<shape::trivial>("trivial");
+    register_shape<shape::nothrow_move>("nothrow_move");
+    register_shape<shape::throwing_move>("throwing_move");
+
+    static char json_format[] = "--benchmark_format=json";
+    std::vector<char*> args(argv, argv + argc);
+    bool has_format = false;
+    for (char* arg : args)
+    {
+        has_format = has_format || std::strncmp(arg, "--benchmark_format", 18) == 0;
+    }
+    if (!has_format)
+    {
+        args.push_back(json_format);
+    }
+
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data()))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+#include <expected/expected.hpp>
+#include <expected/memoize.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// A fallible lookup of a few microseconds, called with skewed keys from several threads:
+// directly, and through std_::memoize with one shard (a single global lock) and with 16.
+// Reports the share of calls answered without running the lookup (cached values, cached
+// errors and coalesced waits).
+
+namespace
+{
+
+constexpr std::uint32_t key_space = 10'000;
+
+std_::expected<std::uint64_t, std::string> slow_lookup(const std::uint32_t& key)
+{
+    std::uint64_t h = key;
+    for (int i = 0; i < 2'000; ++i)
+    {
+        h = h * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    benchmark::DoNotOptimize(h);
+    if (key % 10 == 0)
+    {
+        return std_::unexpected<std::string>("not found");
+    }
+    return h;
+}
+
+using lookup_cache = std_::memoize<decltype(&slow_lookup)>;
+
+lookup_cache& cache(std::int64_t shards)
+{
+    static lookup_cache one(&slow_lookup,
+                            std_::memoize_options{{std::chrono::seconds(10), 8'192},
+                                                  {std::chrono::milliseconds(50), 1'024},
+                                                  1});
+    static lookup_cache sixteen(&slow_lookup,
+                                std_::memoize_options{{std::chrono::seconds(10), 8'192},
+                                                      {std::chrono::milliseconds(50), 1'024},
+                                                      16});
+    return shards == 1 ? one : sixteen;
+}
+
+// Squaring a uniform draw skews it towards small keys, so a minority of keys are hot.
+struct key_source
+{
+    std::uint64_t state;
+
+    std::uint32_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const std::uint64_t u = state >> 48;  // 16 bits
+        return static_cast<std::uint32_t>(u * u * key_space >> 32);
+    }
+};
+
+void BM_direct_lookup(benchmark::State& state)
+{
+    key_source keys{0x9E3779B97F4A7C15ull + static_cast<std::uint64_t>(state.thread_index())};
+    for (auto _ : state)
+    {
+        auto r = slow_lookup(keys.next());
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_direct_lookup)->Threads(1)->Threads(4)->UseRealTime();
+
+void BM_memoized_lookup(benchmark::State& state)
+{
+    lookup_cache& memo = cache(state.range(0));
+    key_source keys{0x9E3779B97F4A7C15ull + static_cast<std::uint64_t>(state.thread_index())};
+    const std_::memoize_stats before = memo.stats();
+    for (auto _ : state)
+    {
+        auto r = memo(keys.next());
+        benchmark::DoNotOptimize(r);
+    }
+    if (state.thread_index() == 0)
+    {
+        const std_::memoize_stats after = memo.stats();
+        const double served = static_cast<double>(after.hits + after.error_hits + after.coalesced
+                                                  - before.hits - before.error_hits
+                                                  - before.coalesced);
+        const double computed = static_cast<double>(after.misses - before.misses);
+        state.counters["hit_rate"] = served / (served + computed);
+    }
+}
+BENCHMARK(BM_memoized_lookup)
+    ->ArgName("shards")
+    ->Arg(1)
+    ->Arg(16)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(8)
+    ->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+#include <expected/expected.hpp>
+#include <expected/parse.hpp>
+
+#include <charconv>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// std_::parse<int> against the std::stoi + catch pattern it replaces (examples/example2.cpp
+// before the switch), for valid and invalid input, plus the 8/16-digit SWAR path against
+// plain from_chars and parse_many over a comma-separated buffer.
+
+namespace
+{
+
+std_::expected<int, std::string> stoi_catch(const std::string& text)
+{
+    try
+    {
+        return std::stoi(text);
+    }
+    catch (const std::exception&)
+    {
+        return std_::unexpected<std::string>("Invalid number format");
+    }
+}
+
+const std::vector<std::string>& inputs(bool valid)
+{
+    static const std::vector<std::string> good = {"42", "-17", "123456", "98765432", "7", "-2048"};
+    static const std::vector<std::string> bad = {"abc", "x1", "", "-", "zz", "?"};
+    return valid ? good : bad;
+}
+
+void BM_stoi_catch(benchmark::State& state)
+{
+    const auto& texts = inputs(state.range(0) != 0);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto r = stoi_catch(texts[i++ % texts.size()]);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_stoi_catch)->ArgName("valid")->Arg(1)->Arg(0);
+
+void BM_parse_int(benchmark::State& state)
+{
+    const auto& texts = inputs(state.range(0) != 0);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto r = std_::parse<int>(texts[i++ % texts.size()]);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_parse_int)->ArgName("valid")->Arg(1)->Arg(0);
+
+const std::vector<std::string>& wide_numbers(std::size_t digits)
+{
+    static std::vector<std::string> eight;
+    static std::vector<std::string> sixteen;
+    auto& out = digits == 8 ? eight : sixteen;
+    if (out.empty())
+    {
+        std::uint64_t x = 0x9E3779B97F4A7C15ull;
+        for (int i = 0; i < 256; ++i)
+        {
+            std::string s;
+            for (std::size_t d = 0; d < digits; ++d)
+            {
+                x = x * 6364136223846793005ull + 1442695040888963407ull;
+                s += static_cast<char>('0' + (x >> 60) % 10);
+            }
+            s[0] = s[0] == '0' ? '1' : s[0];
+            out.push_back(s);
+        }
+    }
+    return out;
+}
+
+void BM_from_chars_wide(benchmark::State& state)
+{
+    const auto& texts = wide_numbers(static_cast<std::size_t>(state.range(0)));
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        const std::string& t = texts[i++ % texts.size()];
+        std::int64_t v = 0;
+        auto r = std::from_chars(t.data(), t.data() + t.size(), v);
+        benchmark::DoNotOptimize(r);
+        benchmark::DoNotOptimize(v);
+    }
+}
+BENCHMARK(BM_from_chars_wide)->ArgName("digits")->Arg(8)->Arg(16);
+
+void BM_parse_wide(benchmark::State& state)
+{
+    const auto& texts = wide_numbers(static_cast<std::size_t>(state.range(0)));
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto r = std_::parse<std::int64_t>(texts[i++ % texts.size()]);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_parse_wide)->ArgName("digits")->Arg(8)->Arg(16);
+
+void BM_parse_many(benchmark::State& state)
+{
+    std::string buffer;
+    for (const std::string& t : wide_numbers(8))
+    {
+        buffer += t;
+        buffer += ',';
+    }
+    std::vector<std::int64_t> out(wide_numbers(8).size());
+    for (auto _ : state)
+    {
+        auto n = std_::parse_many<std::int64_t>(buffer, ',', std::span<std::int64_t>(out));
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * out.size()));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * buffer.size()));
+}
+BENCHMARK(BM_parse_many);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,100 @@
+#include "perf_counters.hpp"
+
+#include <benchmark/benchmark.h>
+#include <expected/expected.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// expected operations with hardware counters attached: the predictable and unpredictable
+// variants take the same number of instructions, so a gap in time should show up as
+// branch-misses rather than instructions.
+
+namespace
+{
+
+constexpr std::size_t pool_size = 4'096;
+
+std::vector<std_::expected<int, std::string>> make_inputs(bool unpredictable)
+{
+    std::vector<std_::expected<int, std::string>> inputs;
+    inputs.reserve(pool_size);
+    std::uint32_t x = 88'675'123u;
+    for (std::size_t i = 0; i < pool_size; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        const bool fail = unpredictable ? (x & 1u) != 0 : i % 2 == 1;
+        if (fail)
+        {
+            inputs.emplace_back(std_::unexpected<std::string>("err"));
+        }
+        else
+        {
+            inputs.emplace_back(static_cast<int>(i));
+        }
+    }
+    return inputs;
+}
+
+}  // namespace
+
+class ExpectedCounters : public bench::perf_counter_fixture
+{
+};
+
+BENCHMARK_DEFINE_F(ExpectedCounters, value_or)(benchmark::State& state)
+{
+    const auto inputs = make_inputs(state.range(0) != 0);
+    std::size_t i = 0;
+    bench::counted_scope counted(counters());
+    for (auto _ : state)
+    {
+        int v = inputs[i].value_or(-1);
+        benchmark::DoNotOptimize(v);
+        i = (i + 1) % pool_size;
+    }
+}
+
+BENCHMARK_DEFINE_F(ExpectedCounters, and_then_chain)(benchmark::State& state)
+{
+    const auto inputs = make_inputs(state.range(0) != 0);
+    const auto step = [](int v)
+    {
+        return std_::expected<int, std::string>(v + 1);
+    };
+    std::size_t i = 0;
+    bench::counted_scope counted(counters());
+    for (auto _ : state)
+    {
+        auto r = inputs[i].and_then(step).and_then(step).transform(
+            [](int v)
+            {
+                return v * 2;
+            });
+        benchmark::DoNotOptimize(r);
+        i = (i + 1) % pool_size;
+    }
+}
+
+BENCHMARK_DEFINE_F(ExpectedCounters, copy)(benchmark::State& state)
+{
+    const auto inputs = make_inputs(state.range(0) != 0);
+    std::size_t i = 0;
+    bench::counted_scope counted(counters());
+    for (auto _ : state)
+    {
+        std_::expected<int, std::string> copy(inputs[i]);
+        benchmark::DoNotOptimize(copy);
+        i = (i + 1) % pool_size;
+    }
+}
+
+BENCHMARK_REGISTER_F(ExpectedCounters, value_or)->ArgName("unpredictable")->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(ExpectedCounters, and_then_chain)->ArgName("unpredictable")->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(ExpectedCounters, copy)->ArgName("unpredictable")->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
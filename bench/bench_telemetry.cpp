@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+#include <expected/expected.hpp>
+#include <expected/telemetry.hpp>
+
+#include <typeinfo>
+
+// Cost of the STD_EXPECTED_TELEMETRY hooks (this file is always built with them enabled, see
+// bench/CMakeLists.txt). BM_error_baseline builds the same error value without going through
+// unexpected<E>; the difference to BM_unexpected_tracked is the per-error telemetry cost.
+
+namespace
+{
+
+struct status
+{
+    int code;
+    const char* reason;
+};
+
+void BM_error_baseline(benchmark::State& state)
+{
+    int code = 0;
+    for (auto _ : state)
+    {
+        status s{++code, "io"};
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_error_baseline)->ThreadRange(1, 4);
+
+void BM_unexpected_tracked(benchmark::State& state)
+{
+    int code = 0;
+    for (auto _ : state)
+    {
+        std_::unexpected<status> e(status{++code, "io"});
+        benchmark::DoNotOptimize(e);
+    }
+}
+BENCHMARK(BM_unexpected_tracked)->ThreadRange(1, 4);
+
+void BM_record_direct(benchmark::State& state)
+{
+    const auto site = std_::source_location::current();
+    for (auto _ : state)
+    {
+        std_::telemetry::record(typeid(status), std_::telemetry::event::construct, site);
+    }
+}
+BENCHMARK(BM_record_direct)->ThreadRange(1, 4);
+
+std_::expected<int, status> fail_at(int site)
+{
+    // Eight distinct call sites, so lookups spread over several slots.
+    switch (site & 7)
+    {
+    case 0: return std_::unexpected<status>(status{0, "a"});
+    case 1: return std_::unexpected<status>(status{1, "b"});
+    case 2: return std_::unexpected<status>(status{2, "c"});
+    case 3: return std_::unexpected<status>(status{3, "d"});
+    case 4: return std_::unexpected<status>(status{4, "e"});
+    case 5: return std_::unexpected<status>(status{5, "f"});
+    case 6: return std_::unexpected<status>(status{6, "g"});
+    default: return std_::unexpected<status>(status{7, "h"});
+    }
+}
+
+void BM_eight_sites(benchmark::State& state)
+{
+    int i = 0;
+    for (auto _ : state)
+    {
+        auto r = fail_at(i++);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_eight_sites);
+
+// Eight independent errors per iteration, from eight call sites, against the same eight values
+// built without unexpected<E>. Consecutive increments hit different counters, so the per-item
+// difference is the hook itself rather than a store-to-load chain on a single counter.
+void BM_eight_sites_baseline(benchmark::State& state)
+{
+    int code = 0;
+    for (auto _ : state)
+    {
+        status s0{code, "a"}, s1{code, "b"}, s2{code, "c"}, s3{code, "d"};
+        status s4{code, "e"}, s5{code, "f"}, s6{code, "g"}, s7{code, "h"};
+        benchmark::DoNotOptimize(s0), benchmark::DoNotOptimize(s1);
+        benchmark::DoNotOptimize(s2), benchmark::DoNotOptimize(s3);
+        benchmark::DoNotOptimize(s4), benchmark::DoNotOptimize(s5);
+        benchmark::DoNotOptimize(s6), benchmark::DoNotOptimize(s7);
+        ++code;
+    }
+    state.SetItemsProcessed(state.iterations() * 8);
+}
+BENCHMARK(BM_eight_sites_baseline);
+
+void BM_eight_sites_unrolled(benchmark::State& state)
+{
+    int code = 0;
+    for (auto _ : state)
+    {
+        std_::unexpected<status> e0(status{code, "a"}), e1(status{code, "b"});
+        std_::unexpected<status> e2(status{code, "c"}), e3(status{code, "d"});
+        std_::unexpected<status> e4(status{code, "e"}), e5(status{code, "f"});
+        std_::unexpected<status> e6(status{code, "g"}), e7(status{code, "h"});
+        benchmark::DoNotOptimize(e0), benchmark::DoNotOptimize(e1);
+        benchmark::DoNotOptimize(e2), benchmark::DoNotOptimize(e3);
+        benchmark::DoNotOptimize(e4), benchmark::DoNotOptimize(e5);
+        benchmark::DoNotOptimize(e6), benchmark::DoNotOptimize(e7);
+        ++code;
+    }
+    state.SetItemsProcessed(state.iterations() * 8);
+}
+BENCHMARK(BM_eight_sites_unrolled);
+
+void BM_transition(benchmark::State& state)
+{
+    std_::expected<int, status> r(1);
+    for (auto _ : state)
+    {
+        r = std_::unexpected<status>(status{1, "x"});
+        benchmark::DoNotOptimize(r);
+        r = 1;
+    }
+}
+BENCHMARK(BM_transition);
+
+void BM_snapshot(benchmark::State& state)
+{
+    for (int i = 0; i < 64; ++i)
+    {
+        (void)fail_at(i);
+    }
+    for (auto _ : state)
+    {
+        auto sites = std_::telemetry::snapshot();
+        benchmark::DoNotOptimize(sites.data());
+    }
+}
+BENCHMARK(BM_snapshot);
+
+}  // namespace
+
+BENCHMARK_MAIN();
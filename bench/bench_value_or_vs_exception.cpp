@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 #include <expected/expected.hpp>
+#include <expected/try_invoke.hpp>
 
 #include <stdexcept>
 
@@ -12,6 +13,21 @@ int heavy_compute()
     return x;
 }
 
+int heavy_compute_noexcept() noexcept
+{
+    return heavy_compute();
+}
+
+int throw_runtime_error()
+{
+    throw std::runtime_error("err");
+}
+
+int throw_logic_error()
+{
+    throw std::logic_error("err");
+}
+
 static void BM_value_or_success(benchmark::State& state)
 {
     for (auto _ : state)
@@ -63,9 +79,68 @@ static void BM_exception_error(benchmark::State& state)
     }
 }
 
+// std_::try_invoke around the same calls, against the try/catch blocks above. The error
+// cases cover a listed type (copied into the variant) and an unlisted one (exception_ptr).
+static void BM_try_invoke_success(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        int v = std_::try_invoke<std::runtime_error>(heavy_compute).value_or(-1);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+static void BM_try_invoke_noexcept_success(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        int v = std_::try_invoke<std::runtime_error>(heavy_compute_noexcept).value_or(-1);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+static void BM_try_invoke_error(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        int v = std_::try_invoke<std::runtime_error>(throw_runtime_error).value_or(-1);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+static void BM_try_invoke_unlisted_error(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        int v = std_::try_invoke<std::runtime_error>(throw_logic_error).value_or(-1);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+static void BM_exception_ptr_error(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        try
+        {
+            throw_runtime_error();
+        }
+        catch (...)
+        {
+            std::exception_ptr p = std::current_exception();
+            benchmark::DoNotOptimize(p);
+        }
+    }
+}
+
 BENCHMARK(BM_value_or_success);
 BENCHMARK(BM_exception_success);
 BENCHMARK(BM_value_or_error);
 BENCHMARK(BM_exception_error);
+BENCHMARK(BM_try_invoke_success);
+BENCHMARK(BM_try_invoke_noexcept_success);
+BENCHMARK(BM_try_invoke_error);
+BENCHMARK(BM_try_invoke_unlisted_error);
+BENCHMARK(BM_exception_ptr_error);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,334 @@
+#include <benchmark/benchmark.h>
+#include <expected/expected.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// The same workloads through std_::expected, C++23 std::expected and, when its header is on
+// the include path (-DTL_EXPECTED_INCLUDE_DIR=...), tl::expected. After the normal output a
+// table lists each operation's cost relative to std::expected; a ratio well above 1 is a
+// codegen gap in the polyfill. Built as C++23 when the compiler supports it; without
+// <expected> only the polyfill rows are produced, and std::expected implementations that
+// predate the monadic operations leave those rows relative to the polyfill itself.
+
+#if defined(__has_include)
+#    if __has_include(<expected>)
+#        include <expected>
+#    endif
+#    if __has_include(<tl/expected.hpp>)
+#        include <tl/expected.hpp>
+#        define STD_EXPECTED_BENCH_HAS_TL 1
+#    endif
+#endif
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+#    define STD_EXPECTED_BENCH_HAS_STD 1
+#endif
+
+// and_then / transform / or_else / transform_error arrived in P2505 (e.g. GCC 13).
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202211L
+#    define STD_EXPECTED_BENCH_HAS_STD_MONADIC 1
+#endif
+
+template <template <class, class> class Expected, template <class> class Unexpected>
+struct contender
+{
+    template <class T, class E>
+    using expected = Expected<T, E>;
+
+    template <class E>
+    using unexpected = Unexpected<E>;
+};
+
+using polyfill = contender<std_::expected, std_::unexpected>;
+#if defined(STD_EXPECTED_BENCH_HAS_STD)
+using standard = contender<std::expected, std::unexpected>;
+#endif
+#if defined(STD_EXPECTED_BENCH_HAS_TL)
+using tartan = contender<tl::expected, tl::unexpected>;
+#endif
+
+namespace
+{
+
+constexpr std::size_t pool_size = 1'024;
+
+// 25% failures in a fixed pseudo-random order, identical for every contender.
+template <class C>
+std::vector<typename C::template expected<int, int>> make_pool()
+{
+    std::vector<typename C::template expected<int, int>> pool;
+    pool.reserve(pool_size);
+    std::uint32_t x = 123'456'789u;
+    for (std::size_t i = 0; i < pool_size; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        if ((x & 3u) == 0)
+        {
+            pool.emplace_back(typename C::template unexpected<int>(static_cast<int>(i)));
+        }
+        else
+        {
+            pool.emplace_back(static_cast<int>(i));
+        }
+    }
+    return pool;
+}
+
+}  // namespace
+
+template <class C>
+static void BM_construct_value(benchmark::State& state)
+{
+    int i = 0;
+    for (auto _ : state)
+    {
+        typename C::template expected<int, int> e(i++);
+        benchmark::DoNotOptimize(e);
+    }
+}
+
+template <class C>
+static void BM_construct_error(benchmark::State& state)
+{
+    int i = 0;
+    for (auto _ : state)
+    {
+        typename C::template expected<int, int> e(typename C::template unexpected<int>(i++));
+        benchmark::DoNotOptimize(e);
+    }
+}
+
+template <class C>
+static void BM_copy_string(benchmark::State& state)
+{
+    const typename C::template expected<std::string, int> src(std::string(48, 'v'));
+    for (auto _ : state)
+    {
+        auto copy = src;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+template <class C>
+static void BM_move_string_error(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        typename C::template expected<int, std::string> src(
+            typename C::template unexpected<std::string>("short error"));
+        auto moved = std::move(src);
+        benchmark::DoNotOptimize(moved);
+    }
+}
+
+template <class C>
+static void BM_swap(benchmark::State& state)
+{
+    auto pool = make_pool<C>();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        pool[i].swap(pool[(i + 1) % pool_size]);
+        benchmark::DoNotOptimize(pool[i]);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class C>
+static void BM_value_or(benchmark::State& state)
+{
+    const auto pool = make_pool<C>();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        int v = pool[i].value_or(-1);
+        benchmark::DoNotOptimize(v);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class C>
+static void BM_and_then_chain(benchmark::State& state)
+{
+    using result = typename C::template expected<int, int>;
+    const auto pool = make_pool<C>();
+    const auto step = [](int v)
+    {
+        return v % 7 == 0 ? result(typename C::template unexpected<int>(v)) : result(v + 1);
+    };
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto r = pool[i].and_then(step).and_then(step).and_then(step);
+        benchmark::DoNotOptimize(r);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class C>
+static void BM_transform(benchmark::State& state)
+{
+    const auto pool = make_pool<C>();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto r = pool[i].transform(
+            [](int v)
+            {
+                return static_cast<long>(v) * 3;
+            });
+        benchmark::DoNotOptimize(r);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class C>
+static void BM_or_else(benchmark::State& state)
+{
+    using result = typename C::template expected<int, int>;
+    const auto pool = make_pool<C>();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto r = pool[i].or_else(
+            [](int e)
+            {
+                return result(-e);
+            });
+        benchmark::DoNotOptimize(r);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class C>
+static void BM_transform_error(benchmark::State& state)
+{
+    const auto pool = make_pool<C>();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto r = pool[i].transform_error(
+            [](int e)
+            {
+                return static_cast<long>(e) << 1;
+            });
+        benchmark::DoNotOptimize(r);
+        i = (i + 1) % pool_size;
+    }
+}
+
+template <class C>
+void register_contender(const std::string& name)
+{
+    const auto add = [&name](const char* op, void (*fn)(benchmark::State&))
+    {
+        benchmark::RegisterBenchmark((std::string(op) + "/" + name).c_str(), fn);
+    };
+    add("construct_value", BM_construct_value<C>);
+    add("construct_error", BM_construct_error<C>);
+    add("copy_string", BM_copy_string<C>);
+    add("move_string_error", BM_move_string_error<C>);
+    add("swap", BM_swap<C>);
+    add("value_or", BM_value_or<C>);
+}
+
+template <class C>
+void register_monadic(const std::string& name)
+{
+    const auto add = [&name](const char* op, void (*fn)(benchmark::State&))
+    {
+        benchmark::RegisterBenchmark((std::string(op) + "/" + name).c_str(), fn);
+    };
+    add("and_then_chain", BM_and_then_chain<C>);
+    add("transform", BM_transform<C>);
+    add("or_else", BM_or_else<C>);
+    add("transform_error", BM_transform_error<C>);
+}
+
+// Console output as usual, then one row per operation with each contender's time relative
+// to std::expected (or to the polyfill when <expected> is unavailable).
+class relative_cost_reporter : public benchmark::ConsoleReporter
+{
+public:
+    void ReportRuns(const std::vector<Run>& runs) override
+    {
+        benchmark::ConsoleReporter::ReportRuns(runs);
+        for (const Run& run : runs)
+        {
+            if (run.run_type != Run::RT_Iteration || run.iterations == 0)
+            {
+                continue;
+            }
+            const std::string name = run.benchmark_name();
+            const std::size_t slash = name.rfind('/');
+            if (slash == std::string::npos)
+            {
+                continue;
+            }
+            times_[name.substr(0, slash)][name.substr(slash + 1)] = run.GetAdjustedRealTime();
+        }
+    }
+
+    void Finalize() override
+    {
+        benchmark::ConsoleReporter::Finalize();
+        std::FILE* out = stdout;
+        std::fprintf(out, "\n%-20s %10s %10s %10s %8s %10s %8s\n", "operation", "std_", "std",
+                     "std_/std", "", "tl", "tl/std");
+        for (const auto& op : times_)
+        {
+            const auto get = [&op](const char* who)
+            {
+                const auto it = op.second.find(who);
+                return it != op.second.end() ? it->second : 0.0;
+            };
+            const double mine = get("std_");
+            const double std_time = get("std");
+            const double tl_time = get("tl");
+            const double base = std_time > 0.0 ? std_time : mine;
+            std::fprintf(out, "%-20s %10.2f %10.2f %10.2f %8s %10.2f %8.2f\n", op.first.c_str(),
+                         mine, std_time, base > 0.0 ? mine / base : 0.0,
+                         base > 0.0 && mine / base > 1.10 ? "<-- gap" : "", tl_time,
+                         base > 0.0 ? tl_time / base : 0.0);
+        }
+    }
+
+private:
+    std::map<std::string, std::map<std::string, double>> times_;
+};
+
+int main(int argc, char** argv)
+{
+    register_contender<polyfill>("std_");
+    register_monadic<polyfill>("std_");
+#if defined(STD_EXPECTED_BENCH_HAS_STD)
+    register_contender<standard>("std");
+#    if defined(STD_EXPECTED_BENCH_HAS_STD_MONADIC)
+    register_monadic<standard>("std");
+#    endif
+#else
+    std::fputs("note: <expected> unavailable; only std_::expected is measured\n", stderr);
+#endif
+#if defined(STD_EXPECTED_BENCH_HAS_TL)
+    register_contender<tartan>("tl");
+    register_monadic<tartan>("tl");
+#endif
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    relative_cost_reporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+#include <expected/wire.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Shipping 4096 results of expected<sample, io_status> (10% errors) through the batch format
+// versus the ad-hoc struct it replaces (tag + both payloads side by side). `bytes_per_item`
+// is what goes over the wire; throughput is reported per encoded byte.
+
+namespace
+{
+
+namespace wire = std_::wire;
+
+struct io_status
+{
+    std::int32_t code;
+    std::uint16_t retry_after;
+};
+
+struct sample
+{
+    double value;
+    std::uint64_t timestamp;
+};
+
+using Result = std_::expected<sample, io_status>;
+
+// What callers wrote by hand before the wire format.
+struct adhoc_result
+{
+    bool ok;
+    sample value;
+    io_status error;
+};
+
+std::vector<Result> make_results(std::size_t n)
+{
+    std::vector<Result> out;
+    out.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (i % 10 == 3)
+        {
+            out.push_back(std_::unexpected<io_status>(io_status{static_cast<std::int32_t>(i), 1}));
+        }
+        else
+        {
+            out.push_back(sample{static_cast<double>(i), i});
+        }
+    }
+    return out;
+}
+
+constexpr std::size_t batch_items = 4096;
+
+void BM_adhoc_encode(benchmark::State& state)
+{
+    const auto items = make_results(batch_items);
+    std::vector<adhoc_result> out(items.size());
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            adhoc_result& a = out[i];
+            a.ok = items[i].has_value();
+            if (a.ok)
+            {
+                a.value = *items[i];
+            }
+            else
+            {
+                a.error = items[i].error();
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    const auto bytes = out.size() * sizeof(adhoc_result);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+    state.counters["bytes_per_item"] = static_cast<double>(sizeof(adhoc_result));
+}
+BENCHMARK(BM_adhoc_encode);
+
+void BM_batch_encode(benchmark::State& state)
+{
+    const auto items = make_results(batch_items);
+    std::vector<std::byte> out(wire::encoded_batch_size<sample, io_status>(items));
+    for (auto _ : state)
+    {
+        auto n = wire::encode_batch<sample, io_status>(items, out);
+        benchmark::DoNotOptimize(n);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * out.size()));
+    state.counters["bytes_per_item"] = static_cast<double>(out.size()) / batch_items;
+}
+BENCHMARK(BM_batch_encode);
+
+void BM_single_encode(benchmark::State& state)
+{
+    const auto items = make_results(batch_items);
+    std::vector<std::byte> out(items.size() * wire::max_encoded_size<sample, io_status>);
+    std::size_t used = 0;
+    for (auto _ : state)
+    {
+        used = 0;
+        for (const Result& r : items)
+        {
+            used += *wire::encode(r, std::span<std::byte>(out).subspan(used));
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * used));
+    state.counters["bytes_per_item"] = static_cast<double>(used) / batch_items;
+}
+BENCHMARK(BM_single_encode);
+
+void BM_batch_read(benchmark::State& state)
+{
+    const auto bytes = wire::encode_batch<sample, io_status>(make_results(batch_items)).value();
+    for (auto _ : state)
+    {
+        auto view = wire::batch_view<sample, io_status>::parse(bytes);
+        double sum = 0;
+        for (std::size_t i = 0; i < view->size(); ++i)
+        {
+            auto r = (*view)[i];
+            sum += r ? r->get().value : static_cast<double>(r.error().get().code);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_batch_read);
+
+void BM_batch_read_values_only(benchmark::State& state)
+{
+    const auto bytes = wire::encode_batch<sample, io_status>(make_results(batch_items)).value();
+    for (auto _ : state)
+    {
+        auto view = wire::batch_view<sample, io_status>::parse(bytes);
+        double sum = 0;
+        for (const sample& s : view->values())
+        {
+            sum += s.value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_batch_read_values_only);
+
+}  // namespace
+
+BENCHMARK_MAIN();
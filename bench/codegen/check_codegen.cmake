@@ -0,0 +1,147 @@
+# Codegen regression check, run in script mode (cmake -P).
+#
+# Disassembles the corpus objects, and for every cg_* function records the instruction count
+# (alignment padding excluded) and the stack frame size (8 bytes per push plus the first `sub $N, %rsp`). MODE=update
+# rewrites BASELINE; MODE=check compares against it and fails when a function grows by more
+# than THRESHOLD percent (and at least two instructions / 16 bytes of stack), or when a
+# function disappears.
+#
+# Inputs: OBJDUMP, LEVELS (e.g. "O2;O3"), OBJECT_<level> for each level, BASELINE,
+#         THRESHOLD, MODE.
+
+cmake_minimum_required(VERSION 3.16)
+
+foreach(var OBJDUMP LEVELS BASELINE THRESHOLD MODE)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "check_codegen.cmake: ${var} is not set")
+    endif()
+endforeach()
+
+function(measure_object object level out_var)
+    execute_process(
+        COMMAND ${OBJDUMP} -d --no-show-raw-insn ${object}
+        OUTPUT_VARIABLE listing
+        RESULT_VARIABLE status
+    )
+    if(NOT status EQUAL 0)
+        message(FATAL_ERROR "objdump failed on ${object}")
+    endif()
+
+    string(REPLACE ";" "," listing "${listing}")
+    string(REPLACE "\n" ";" lines "${listing}")
+
+    set(results "")
+    set(current "")
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^[0-9a-f]+ <([A-Za-z0-9_.]+)>:$")
+            if(current)
+                math(EXPR frame "${pushes} * 8 + ${sub}")
+                list(APPEND results "${level} ${current} ${insns} ${frame}")
+            endif()
+            set(symbol "${CMAKE_MATCH_1}")
+            set(current "")
+            if(symbol MATCHES "^cg_")
+                set(current "${symbol}")
+                set(insns 0)
+                set(pushes 0)
+                set(sub 0)
+                set(frame_done FALSE)
+            endif()
+        elseif(current AND line MATCHES "^ +[0-9a-f]+:\t([a-z0-9]+)(.*)$")
+            set(mnemonic "${CMAKE_MATCH_1}")
+            set(operands "${CMAKE_MATCH_2}")
+            # Alignment padding between functions is not part of the function.
+            if(mnemonic MATCHES "^(nop|data16|cs|int3)" OR line MATCHES "xchg +%ax,%ax")
+                continue()
+            endif()
+            math(EXPR insns "${insns} + 1")
+            if(NOT frame_done)
+                if(mnemonic STREQUAL "push")
+                    math(EXPR pushes "${pushes} + 1")
+                elseif(mnemonic STREQUAL "sub" AND operands MATCHES "\\$(0x[0-9a-f]+),%rsp")
+                    math(EXPR sub "${CMAKE_MATCH_1}")
+                    set(frame_done TRUE)
+                endif()
+            endif()
+        endif()
+    endforeach()
+    if(current)
+        math(EXPR frame "${pushes} * 8 + ${sub}")
+        list(APPEND results "${level} ${current} ${insns} ${frame}")
+    endif()
+
+    set(${out_var} "${results}" PARENT_SCOPE)
+endfunction()
+
+set(measured "")
+foreach(level IN LISTS LEVELS)
+    measure_object("${OBJECT_${level}}" ${level} rows)
+    list(APPEND measured ${rows})
+endforeach()
+list(SORT measured)
+
+if(MODE STREQUAL "update")
+    set(content "# level function instructions stack_bytes\n")
+    foreach(row IN LISTS measured)
+        string(APPEND content "${row}\n")
+    endforeach()
+    file(WRITE "${BASELINE}" "${content}")
+    list(LENGTH measured count)
+    message(STATUS "codegen: wrote ${count} entries to ${BASELINE}")
+    return()
+endif()
+
+if(NOT EXISTS "${BASELINE}")
+    message(FATAL_ERROR "codegen: no baseline at ${BASELINE}; build codegen_update_baseline")
+endif()
+
+file(STRINGS "${BASELINE}" baseline_rows REGEX "^[^#]")
+set(failures 0)
+foreach(row IN LISTS baseline_rows)
+    string(REPLACE " " ";" fields "${row}")
+    list(GET fields 0 level)
+    list(GET fields 1 fn)
+    list(GET fields 2 base_insns)
+    list(GET fields 3 base_frame)
+
+    set(found FALSE)
+    foreach(m IN LISTS measured)
+        string(REPLACE " " ";" mf "${m}")
+        list(GET mf 0 m_level)
+        list(GET mf 1 m_fn)
+        if(m_level STREQUAL level AND m_fn STREQUAL fn)
+            list(GET mf 2 insns)
+            list(GET mf 3 frame)
+            set(found TRUE)
+        endif()
+    endforeach()
+
+    if(NOT found)
+        message(SEND_ERROR "codegen: ${level} ${fn} missing from the corpus")
+        math(EXPR failures "${failures} + 1")
+        continue()
+    endif()
+
+    math(EXPR insn_slack "${base_insns} * ${THRESHOLD} / 100")
+    if(insn_slack LESS 2)
+        set(insn_slack 2)
+    endif()
+    math(EXPR frame_slack "${base_frame} * ${THRESHOLD} / 100")
+    if(frame_slack LESS 16)
+        set(frame_slack 16)
+    endif()
+    math(EXPR insn_limit "${base_insns} + ${insn_slack}")
+    math(EXPR frame_limit "${base_frame} + ${frame_slack}")
+
+    set(line "${level} ${fn}: ${insns} insns (baseline ${base_insns}), ${frame} B stack (baseline ${base_frame})")
+    if(insns GREATER insn_limit OR frame GREATER frame_limit)
+        message(SEND_ERROR "codegen regression: ${line}")
+        math(EXPR failures "${failures} + 1")
+    else()
+        message(STATUS "codegen ok: ${line}")
+    endif()
+endforeach()
+
+if(failures GREATER 0)
+    message(FATAL_ERROR "codegen: ${failures} regression(s); if intended, build codegen_update_baseline")
+endif()
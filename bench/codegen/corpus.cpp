@@ -0,0 +1,75 @@
+#include <expected/expected.hpp>
+
+#include <string>
+#include <utility>
+
+// Codegen corpus: one extern "C" function per core operation, so each gets a stable,
+// unmangled symbol whose instruction count and stack frame are tracked by
+// check_codegen.cmake. Keep bodies minimal - anything besides the operation under test
+// shows up in the numbers.
+
+using int_result = std_::expected<int, int>;
+using string_result = std_::expected<std::string, int>;
+
+namespace
+{
+
+inline int_result step(int v)
+{
+    if (v > 1'000)
+    {
+        return std_::unexpected<int>(v);
+    }
+    return v + 1;
+}
+
+}  // namespace
+
+extern "C"
+{
+
+void cg_construct_value(int_result* out, int v)
+{
+    ::new (static_cast<void*>(out)) int_result(v);
+}
+
+void cg_construct_error(int_result* out, int e)
+{
+    ::new (static_cast<void*>(out)) int_result(std_::unexpected<int>(e));
+}
+
+int cg_value_or(const int_result* e)
+{
+    return e->value_or(-1);
+}
+
+int cg_has_value_branch(const int_result* e)
+{
+    if (e->has_value())
+    {
+        return **e * 2;
+    }
+    return e->error() + 1;
+}
+
+void cg_and_then3(int_result* out, const int_result* in)
+{
+    ::new (static_cast<void*>(out)) int_result(in->and_then(step).and_then(step).and_then(step));
+}
+
+void cg_swap(int_result* a, int_result* b)
+{
+    a->swap(*b);
+}
+
+void cg_copy_string(string_result* dst, const string_result* src)
+{
+    *dst = *src;
+}
+
+void cg_swap_string(string_result* a, string_result* b)
+{
+    a->swap(*b);
+}
+
+}  // extern "C"
@@ -0,0 +1,150 @@
+# Build-throughput benchmark, run in script mode (cmake -P).
+#
+# For each N in COUNTS, generates a TU with N distinct expected<T, E> / expected<void, E>
+# instantiations that each go through construction, copy and every monadic operation, then
+# compiles it with -fsyntax-only and reports frontend time. GCC's -ftime-report is parsed;
+# Clang additionally writes a -ftime-trace JSON per TU next to the sources for inspection.
+# The per-instantiation figure is the slope between the smallest and largest N.
+#
+# Inputs: CXX, CXX_ID, STD (e.g. 20), INCLUDE_DIR, OUT_DIR, COUNTS (e.g. "0;100;400").
+
+cmake_minimum_required(VERSION 3.16)
+
+foreach(var CXX CXX_ID STD INCLUDE_DIR OUT_DIR COUNTS)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "measure_compile_time.cmake: ${var} is not set")
+    endif()
+endforeach()
+
+file(MAKE_DIRECTORY "${OUT_DIR}")
+
+function(generate_tu count path)
+    set(src "// Generated by measure_compile_time.cmake - ${count} instantiations.\n")
+    string(APPEND src "#include <expected/expected.hpp>\n\n#include <string>\n\n")
+    string(APPEND src "template <int I>\nstruct value_t\n{\n    int v;\n    std::string s;\n};\n\n")
+    string(APPEND src "template <int I>\nstruct failure_t\n{\n    int code;\n};\n\n")
+    string(APPEND src [=[
+template <int I>
+int exercise(const std_::expected<value_t<I>, failure_t<I>>& in)
+{
+    using result = std_::expected<value_t<I>, failure_t<I>>;
+    result copy = in;
+    result moved = std::move(copy);
+    moved = in;
+    auto r = moved
+                 .and_then(
+                     [](const value_t<I>& v)
+                     {
+                         return result(v);
+                     })
+                 .transform(
+                     [](const value_t<I>& v)
+                     {
+                         return v.v;
+                     })
+                 .or_else(
+                     [](const failure_t<I>& e)
+                     {
+                         return std_::expected<int, failure_t<I>>(e.code);
+                     })
+                 .transform_error(
+                     [](const failure_t<I>& e)
+                     {
+                         return e.code;
+                     });
+    std_::expected<void, failure_t<I>> done = std_::unexpected<failure_t<I>>(failure_t<I>{1});
+    auto d = done.and_then(
+                     []
+                     {
+                         return std_::expected<void, failure_t<I>>();
+                     })
+                 .transform_error(
+                     [](const failure_t<I>& e)
+                     {
+                         return e.code;
+                     });
+    return r.value_or(0) + (d.has_value() ? 1 : 0);
+}
+
+]=])
+    if(count GREATER 0)
+        math(EXPR last "${count} - 1")
+        foreach(i RANGE ${last})
+            string(APPEND src
+                "template int exercise<${i}>(const std_::expected<value_t<${i}>, failure_t<${i}>>&);\n")
+        endforeach()
+    endif()
+    file(WRITE "${path}" "${src}")
+endfunction()
+
+set(report "")
+set(first_count "")
+foreach(count IN LISTS COUNTS)
+    set(tu "${OUT_DIR}/instantiations_${count}.cpp")
+    generate_tu(${count} "${tu}")
+
+    set(flags -std=c++${STD} -I${INCLUDE_DIR} -fsyntax-only -ftime-report)
+    if(CXX_ID MATCHES "Clang")
+        list(APPEND flags -ftime-trace -ftime-trace-granularity=50)
+    endif()
+    execute_process(
+        COMMAND ${CXX} ${flags} ${tu}
+        WORKING_DIRECTORY "${OUT_DIR}"
+        RESULT_VARIABLE status
+        OUTPUT_VARIABLE out
+        ERROR_VARIABLE err
+    )
+    if(NOT status EQUAL 0)
+        message(FATAL_ERROR "compile of ${tu} failed:\n${err}")
+    endif()
+
+    set(total "?")
+    set(parsing "?")
+    set(instantiation "?")
+    if(err MATCHES "TOTAL +: +[0-9.]+ +[0-9.]+ +([0-9.]+)")
+        set(total "${CMAKE_MATCH_1}")
+    elseif(err MATCHES "Total Execution Time: ([0-9.]+) seconds")
+        set(total "${CMAKE_MATCH_1}")
+    endif()
+    if(err MATCHES "phase parsing +: +[0-9.]+ +\\( *[0-9]+%\\) +[0-9.]+ +\\( *[0-9]+%\\) +([0-9.]+)")
+        set(parsing "${CMAKE_MATCH_1}")
+    endif()
+    if(err MATCHES "template instantiation +: +[0-9.]+ +\\( *[0-9]+%\\) +[0-9.]+ +\\( *[0-9]+%\\) +([0-9.]+)")
+        set(instantiation "${CMAKE_MATCH_1}")
+    endif()
+
+    set(line "N=${count}: total ${total} s, parsing ${parsing} s, template instantiation ${instantiation} s")
+    message(STATUS "compile-time ${line}")
+    string(APPEND report "${count},${total},${parsing},${instantiation}\n")
+
+    if(first_count STREQUAL "")
+        set(first_count ${count})
+        set(first_total ${total})
+    endif()
+    set(last_count ${count})
+    set(last_total ${total})
+endforeach()
+
+file(WRITE "${OUT_DIR}/compile_time.csv" "instantiations,total_s,parsing_s,instantiation_s\n${report}")
+
+message(STATUS "compile-time results written to ${OUT_DIR}/compile_time.csv")
+
+function(seconds_to_ms value out_var)
+    if(value MATCHES "^([0-9]+)\\.?([0-9]*)$")
+        set(whole "${CMAKE_MATCH_1}")
+        string(SUBSTRING "${CMAKE_MATCH_2}000" 0 3 frac)
+        math(EXPR ms "${whole} * 1000 + 1${frac} - 1000")
+        set(${out_var} ${ms} PARENT_SCOPE)
+    else()
+        set(${out_var} "" PARENT_SCOPE)
+    endif()
+endfunction()
+
+if(NOT last_count EQUAL first_count)
+    seconds_to_ms("${first_total}" first_ms)
+    seconds_to_ms("${last_total}" last_ms)
+    if(NOT first_ms STREQUAL "" AND NOT last_ms STREQUAL "")
+        math(EXPR per_instantiation "(${last_ms} - ${first_ms}) * 1000 / (${last_count} - ${first_count})")
+        message(STATUS "compile-time per instantiation: ~${per_instantiation} us")
+    endif()
+endif()
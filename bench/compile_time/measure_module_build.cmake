@@ -0,0 +1,145 @@
+# Header vs module build comparison, run in script mode (cmake -P).
+#
+# Generates TUS consumer translation units that use expected the way a typical library TU does
+# (a handful of signatures, a monadic chain, a void result) and compiles all of them twice:
+# once with #include <expected/expected.hpp>, once with `import std_expected;` against a module
+# interface built a single time from MODULE_SOURCE. Reports total wall time of each build,
+# the one-off interface cost, and the per-TU saving. Supports GCC (-fmodules-ts) and Clang.
+#
+# Inputs: CXX, CXX_ID, STD (20 or later), INCLUDE_DIR, MODULE_SOURCE, OUT_DIR, TUS (e.g. 200).
+
+cmake_minimum_required(VERSION 3.23)
+
+foreach(var CXX CXX_ID STD INCLUDE_DIR MODULE_SOURCE OUT_DIR TUS)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "measure_module_build.cmake: ${var} is not set")
+    endif()
+endforeach()
+
+if(CXX_ID STREQUAL "GNU")
+    set(module_flags -fmodules-ts)
+    set(interface_command ${CXX} -std=c++${STD} -I${INCLUDE_DIR} ${module_flags}
+                          -x c++ -c ${MODULE_SOURCE} -o std_expected.o)
+elseif(CXX_ID MATCHES "Clang")
+    set(module_flags -fmodule-file=std_expected=${OUT_DIR}/module/std_expected.pcm)
+    set(interface_command ${CXX} -std=c++${STD} -I${INCLUDE_DIR}
+                          -x c++-module --precompile ${MODULE_SOURCE} -o std_expected.pcm)
+else()
+    message(FATAL_ERROR "measure_module_build.cmake: unsupported compiler ${CXX_ID}")
+endif()
+
+# Consumers include what they need from the standard library before the import: GCC cannot
+# merge a standard header included after an imported module that already pulled it in.
+set(consumer_body [=[
+struct io_error
+{
+    int code;
+};
+
+std_::expected<int, io_error> read_count(int fd)
+{
+    if (fd < 0)
+    {
+        return std_::unexpected<io_error>(io_error{fd});
+    }
+    return fd * 2;
+}
+
+std_::expected<std::string, io_error> read_name(int fd)
+{
+    return read_count(fd).transform(
+        [](int n)
+        {
+            return std::string(static_cast<std::size_t>(n), 'x');
+        });
+}
+
+std_::expected<void, io_error> flush(int fd)
+{
+    return read_name(fd)
+        .and_then(
+            [](const std::string& s) -> std_::expected<void, io_error>
+            {
+                if (s.empty())
+                {
+                    return std_::unexpected<io_error>(io_error{0});
+                }
+                return {};
+            })
+        .or_else(
+            [](io_error e) -> std_::expected<void, io_error>
+            {
+                return std_::unexpected<io_error>(e);
+            });
+}
+]=])
+
+function(now_us out_var)
+    string(TIMESTAMP seconds "%s" UTC)
+    string(TIMESTAMP micros "%f" UTC)
+    math(EXPR value "${seconds} * 1000000 + ${micros}")
+    set(${out_var} ${value} PARENT_SCOPE)
+endfunction()
+
+function(compile_all flavour prelude extra_flags out_var)
+    set(dir "${OUT_DIR}/${flavour}")
+    file(MAKE_DIRECTORY "${dir}")
+    math(EXPR last "${TUS} - 1")
+    foreach(i RANGE ${last})
+        file(WRITE "${dir}/tu_${i}.cpp"
+             "// Generated by measure_module_build.cmake\n${prelude}\nnamespace tu_${i}\n{\n"
+             "${consumer_body}\n}  // namespace tu_${i}\n")
+    endforeach()
+
+    now_us(start)
+    foreach(i RANGE ${last})
+        execute_process(
+            COMMAND ${CXX} -std=c++${STD} ${extra_flags} -c "${dir}/tu_${i}.cpp" -o "${dir}/tu_${i}.o"
+            WORKING_DIRECTORY "${OUT_DIR}/module"
+            RESULT_VARIABLE status
+            ERROR_VARIABLE err
+        )
+        if(NOT status EQUAL 0)
+            message(FATAL_ERROR "${flavour} build of tu_${i}.cpp failed:\n${err}")
+        endif()
+    endforeach()
+    now_us(stop)
+    math(EXPR elapsed "${stop} - ${start}")
+    set(${out_var} ${elapsed} PARENT_SCOPE)
+endfunction()
+
+file(MAKE_DIRECTORY "${OUT_DIR}/module")
+
+now_us(start)
+execute_process(
+    COMMAND ${interface_command}
+    WORKING_DIRECTORY "${OUT_DIR}/module"
+    RESULT_VARIABLE status
+    ERROR_VARIABLE err
+)
+now_us(stop)
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "building the std_expected interface failed:\n${err}")
+endif()
+math(EXPR interface_us "${stop} - ${start}")
+
+compile_all(header
+            "#include <expected/expected.hpp>\n\n#include <cstddef>\n#include <string>\n"
+            "-I${INCLUDE_DIR}" header_us)
+compile_all(module
+            "#include <cstddef>\n#include <string>\n\nimport std_expected;\n"
+            "${module_flags}" module_us)
+
+math(EXPR header_ms "${header_us} / 1000")
+math(EXPR module_ms "${module_us} / 1000")
+math(EXPR interface_ms "${interface_us} / 1000")
+math(EXPR module_total_ms "${module_ms} + ${interface_ms}")
+math(EXPR saved_per_tu_us "(${header_us} - ${module_us}) / ${TUS}")
+
+file(WRITE "${OUT_DIR}/module_build.csv"
+     "tus,header_ms,module_ms,interface_ms\n${TUS},${header_ms},${module_ms},${interface_ms}\n")
+
+message(STATUS "module-build ${TUS} TUs with #include: ${header_ms} ms")
+message(STATUS "module-build ${TUS} TUs with import:   ${module_ms} ms (+ ${interface_ms} ms interface)")
+message(STATUS "module-build saving per TU: ~${saved_per_tu_us} us "
+               "(${module_total_ms} ms including the interface vs ${header_ms} ms)")
@@ -0,0 +1,248 @@
+#ifndef LIB_STD_EXPECTED_BENCH_PERF_COUNTERS_HPP_m4r9zq
+#define LIB_STD_EXPECTED_BENCH_PERF_COUNTERS_HPP_m4r9zq
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+// Hardware counters around the timed loop of each benchmark run. Derive a fixture from
+// perf_counter_fixture and open a counted_scope right before the loop, after any setup:
+//
+//     const auto inputs = make_inputs();
+//     bench::counted_scope counted(counters());
+//     for (auto _ : state) { ... }
+//
+// and every run reports instructions, branches, branch-misses and L1d read misses per
+// iteration as user counters. Setup before the scope and teardown after it are not counted
+// (declare the scope after the data it outlives). Counters that
+// cannot be opened - no PMU access in a container, perf_event_paranoid too high, or not
+// Linux - are left out, with a one-time note on stderr, and the run reports times only. So is
+// a window in which the group was never scheduled on the PMU: it has no sample rather than a
+// sample of zeros.
+
+namespace bench
+{
+
+class perf_counters
+{
+public:
+    static constexpr std::size_t max_events = 4;
+
+    perf_counters() noexcept
+    {
+#if defined(__linux__)
+        static const event events[max_events] = {
+            {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {"branches", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+            {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {"L1d-misses",
+             PERF_TYPE_HW_CACHE,
+             PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                 | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        };
+
+        for (const event& e : events)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = e.type;
+            attr.config = e.config;
+            attr.disabled = leader_ < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                               | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, leader_, 0);
+            if (fd < 0)
+            {
+                if (leader_ < 0)
+                {
+                    return;
+                }
+                continue;
+            }
+            if (leader_ < 0)
+            {
+                leader_ = static_cast<int>(fd);
+            }
+            fds_[count_] = static_cast<int>(fd);
+            names_[count_] = e.name;
+            ++count_;
+        }
+#endif
+    }
+
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    ~perf_counters()
+    {
+#if defined(__linux__)
+        for (std::size_t i = 0; i < count_; ++i)
+        {
+            close(fds_[i]);
+        }
+#endif
+    }
+
+    bool available() const noexcept
+    {
+        return count_ != 0 && !broken_;
+    }
+
+    void start() noexcept
+    {
+        sampled_ = false;
+#if defined(__linux__)
+        if (available())
+        {
+            ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    void stop() noexcept
+    {
+#if defined(__linux__)
+        if (!available())
+        {
+            return;
+        }
+        ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // nr, time_enabled, time_running, then one value per event.
+        std::uint64_t buf[3 + max_events] = {};
+        if (read(leader_, buf, sizeof(buf)) < 0 || buf[0] != count_)
+        {
+            broken_ = true;  // the fds stay open until the destructor closes them
+            return;
+        }
+        if (buf[2] == 0)
+        {
+            return;  // never scheduled: no sample for this window
+        }
+        // Scale for multiplexing when the PMU had to share the group with other users.
+        const double scale = static_cast<double>(buf[1]) / static_cast<double>(buf[2]);
+        for (std::size_t i = 0; i < count_; ++i)
+        {
+            values_[i] = static_cast<double>(buf[3 + i]) * scale;
+        }
+        sampled_ = true;
+#endif
+    }
+
+    // Forgets the last window, so that report() has nothing to report until the next one.
+    void discard() noexcept
+    {
+        sampled_ = false;
+    }
+
+    // Per-iteration averages of the last start()/stop() window.
+    void report(benchmark::State& state) const
+    {
+        if (!available())
+        {
+            static const bool noted =
+                std::fputs("note: hardware perf counters unavailable; reporting times only\n",
+                           stderr)
+                >= 0;
+            (void)noted;
+            return;
+        }
+        if (!sampled_)
+        {
+            static const bool noted =
+                std::fputs("note: no perf counter sample (group not scheduled, or no counted_scope)"
+                           "; no counters for this run\n",
+                           stderr)
+                >= 0;
+            (void)noted;
+            return;
+        }
+        for (std::size_t i = 0; i < count_; ++i)
+        {
+            state.counters[names_[i]] =
+                benchmark::Counter(values_[i], benchmark::Counter::kAvgIterations);
+        }
+    }
+
+private:
+    struct event
+    {
+        const char* name;
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+
+    int leader_ = -1;
+    std::size_t count_ = 0;  // open fds, including the leader
+    bool broken_ = false;    // a read failed; counting is off for good
+    bool sampled_ = false;   // values_ hold the last start()/stop() window
+    int fds_[max_events] = {};
+    const char* names_[max_events] = {};
+    double values_[max_events] = {};
+};
+
+// Counts from construction to destruction.
+class counted_scope
+{
+public:
+    explicit counted_scope(perf_counters& counters) noexcept : counters_(counters)
+    {
+        counters_.start();
+    }
+
+    counted_scope(const counted_scope&) = delete;
+    counted_scope& operator=(const counted_scope&) = delete;
+
+    ~counted_scope()
+    {
+        counters_.stop();
+    }
+
+private:
+    perf_counters& counters_;
+};
+
+// Reports the window of the counted_scope opened in the benchmark body; a run without one
+// reports no counters.
+class perf_counter_fixture : public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& state) override
+    {
+        (void)state;
+        counters_.discard();
+    }
+
+    void TearDown(benchmark::State& state) override
+    {
+        counters_.report(state);
+    }
+
+protected:
+    perf_counters& counters() noexcept
+    {
+        return counters_;
+    }
+
+private:
+    perf_counters counters_;
+};
+
+}  // namespace bench
+
+#endif  // End of include guard: LIB_STD_EXPECTED_BENCH_PERF_COUNTERS_HPP_m4r9zq
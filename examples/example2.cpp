@@ -1,4 +1,5 @@
 #include <expected/expected.hpp>
+#include <expected/parse.hpp>
 
 #include <iostream>
 #include <string>
@@ -28,14 +29,11 @@ std_::expected<std::string, FileError> read_file(const std::string& filename)
 
 std_::expected<int, std::string> parse_number(const std::string& str)
 {
-    try
-    {
-        return std::stoi(str);
-    }
-    catch (const std::exception&)
-    {
-        return std_::unexpected<std::string>("Invalid number format");
-    }
+    return std_::parse<int>(str).transform_error(
+        [](std_::parse_error)
+        {
+            return std::string("Invalid number format");
+        });
 }
 
 int main()
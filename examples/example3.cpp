@@ -1,4 +1,5 @@
 #include <expected/expected.hpp>
+#include <expected/parse.hpp>
 
 #include <iostream>
 #include <string>
@@ -21,14 +22,11 @@ std_::expected<std::string, std::string> int_to_string(int x)
 
 std_::expected<int, std::string> string_to_int(const std::string& str)
 {
-    try
-    {
-        return std::stoi(str);
-    }
-    catch (...)
-    {
-        return std_::unexpected<std::string>("Invalid number");
-    }
+    return std_::parse<int>(str).transform_error(
+        [](std_::parse_error)
+        {
+            return std::string("Invalid number");
+        });
 }
 
 std_::expected<std::vector<int>, std::string> create_vector(int size)
@@ -0,0 +1,69 @@
+#ifndef LIB_STD_EXPECTED_C_RESULT_H_w3j8ka
+#define LIB_STD_EXPECTED_C_RESULT_H_w3j8ka
+
+#include <stdint.h>
+
+/*
+ * C view of expected results, for C APIs over C++ components and for other FFI consumers.
+ * A result is returned by value as
+ *
+ *     struct name {
+ *         uint32_t tag;                                   STD_EXPECTED_C_VALUE or _ERROR
+ *         union { value_type value; error_type error; } u;
+ *     };
+ *
+ * with the ordinary C layout rules: u starts at offset 4 rounded up to the union's alignment,
+ * and the struct's alignment is the larger of 4 and the union's. Results without a value use
+ * union { error_type error; } u. In C, STD_EXPECTED_C_RESULT declares that struct; in C++ it
+ * names std_::c_result<value_type, error_type> (see c_result.hpp), which has the same layout,
+ * so one header declares the extern "C" functions for both sides.
+ *
+ * value_type and error_type must be plain C types: scalars, pointers or C structs.
+ */
+
+#define STD_EXPECTED_C_ERROR 0u
+#define STD_EXPECTED_C_VALUE 1u
+
+#define STD_EXPECTED_C_HAS_VALUE(result) ((result).tag == STD_EXPECTED_C_VALUE)
+
+#if defined(__cplusplus)
+
+#    define STD_EXPECTED_C_RESULT(name, value_type, error_type)                                    \
+        typedef ::std_::c_result<value_type, error_type> name
+#    define STD_EXPECTED_C_RESULT_VOID(name, error_type)                                           \
+        typedef ::std_::c_result<void, error_type> name
+
+#else
+
+#    define STD_EXPECTED_C_RESULT(name, value_type, error_type)                                    \
+        typedef struct name                                                                        \
+        {                                                                                          \
+            uint32_t tag;                                                                          \
+            union                                                                                  \
+            {                                                                                      \
+                value_type value;                                                                  \
+                error_type error;                                                                  \
+            } u;                                                                                   \
+        } name
+#    define STD_EXPECTED_C_RESULT_VOID(name, error_type)                                           \
+        typedef struct name                                                                        \
+        {                                                                                          \
+            uint32_t tag;                                                                          \
+            union                                                                                  \
+            {                                                                                      \
+                error_type error;                                                                  \
+            } u;                                                                                   \
+        } name
+
+/* Compound literals (C99) for returning results from C. */
+#    define STD_EXPECTED_C_MAKE_VALUE(name, v) ((name){STD_EXPECTED_C_VALUE, {.value = (v)}})
+#    define STD_EXPECTED_C_MAKE_ERROR(name, e) ((name){STD_EXPECTED_C_ERROR, {.error = (e)}})
+#    define STD_EXPECTED_C_MAKE_VOID(name) ((name){STD_EXPECTED_C_VALUE, {0}})
+
+#endif
+
+#if defined(__cplusplus)
+#    include <expected/c_result.hpp>
+#endif
+
+#endif /* End of include guard: LIB_STD_EXPECTED_C_RESULT_H_w3j8ka */
@@ -0,0 +1,121 @@
+#ifndef LIB_STD_EXPECTED_C_RESULT_HPP_w3j8kb
+#define LIB_STD_EXPECTED_C_RESULT_HPP_w3j8kb
+
+#include <expected/c_result.h>
+#include <expected/expected.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// C++ side of c_result.h. c_result<T, E> is the tag + union layout documented there, for
+// trivially copyable, standard-layout T and E; the layout is checked at compile time wherever
+// as_c() or from_c() is instantiated. Both conversions build the other representation in place
+// from one copy of the value or error, with no heap allocation and no out-parameters, so an
+// extern "C" function can simply `return std_::as_c(compute());`.
+
+namespace std_
+{
+
+template <class T, class E>
+struct c_result
+{
+    std::uint32_t tag;
+    union
+    {
+        T value;
+        E error;
+    } u;
+};
+
+template <class E>
+struct c_result<void, E>
+{
+    std::uint32_t tag;
+    union
+    {
+        E error;
+    } u;
+};
+
+namespace detail
+{
+
+constexpr std::size_t c_round_up(std::size_t n, std::size_t alignment) noexcept
+{
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+template <class T>
+constexpr bool is_c_compatible()
+{
+    return std::is_void<T>::value
+           || (std::is_trivially_copyable<T>::value && std::is_standard_layout<T>::value);
+}
+
+template <class T, class E>
+constexpr bool check_c_layout()
+{
+    using result = c_result<T, E>;
+    using payload = decltype(result::u);
+
+    static_assert(is_c_compatible<T>() && is_c_compatible<E>(),
+                  "c_result needs trivially copyable, standard-layout T and E");
+    static_assert(std::is_standard_layout<result>::value
+                      && std::is_trivially_copyable<result>::value,
+                  "c_result must be a plain C struct");
+    static_assert(offsetof(result, tag) == 0, "tag comes first");
+    static_assert(offsetof(result, u) == c_round_up(sizeof(std::uint32_t), alignof(payload)),
+                  "the union follows the tag at its natural alignment");
+    static_assert(alignof(result) == (alignof(payload) > 4 ? alignof(payload) : 4),
+                  "c_result is aligned like the larger of uint32_t and the union");
+    static_assert(sizeof(result) == c_round_up(offsetof(result, u) + sizeof(payload),
+                                               alignof(result)),
+                  "no padding beyond what C adds");
+    return true;
+}
+
+}  // namespace detail
+
+template <class T, class E>
+constexpr c_result<T, E> as_c(const expected<T, E>& r) noexcept
+{
+    static_assert(detail::check_c_layout<T, E>(), "");
+
+    if (!r.has_value())
+    {
+        return c_result<T, E>{STD_EXPECTED_C_ERROR, {.error = r.error()}};
+    }
+    if constexpr (std::is_void<T>::value)
+    {
+        return c_result<T, E>{STD_EXPECTED_C_VALUE, {}};
+    }
+    else
+    {
+        return c_result<T, E>{STD_EXPECTED_C_VALUE, {.value = *r}};
+    }
+}
+
+// Any tag other than STD_EXPECTED_C_VALUE is read as an error.
+template <class T, class E>
+constexpr expected<T, E> from_c(const c_result<T, E>& c) noexcept
+{
+    static_assert(detail::check_c_layout<T, E>(), "");
+
+    if (c.tag != STD_EXPECTED_C_VALUE)
+    {
+        return unexpected<E>(c.u.error);
+    }
+    if constexpr (std::is_void<T>::value)
+    {
+        return expected<T, E>();
+    }
+    else
+    {
+        return c.u.value;
+    }
+}
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_C_RESULT_HPP_w3j8kb
@@ -0,0 +1,347 @@
+#ifndef LIB_STD_EXPECTED_ERROR_CONTEXT_HPP_w6n1hz
+#define LIB_STD_EXPECTED_ERROR_CONTEXT_HPP_w6n1hz
+
+#include <expected/expected.hpp>
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Pointer-sized error type whose context frames live in a thread-local bump arena. Each
+// with_context() call prepends one frame, so adding context while unwinding costs one bump
+// allocation instead of a string concatenation per layer. Frames stay valid until the
+// enclosing context_scope on the allocating thread ends; call to_string() to keep the text
+// beyond that.
+
+namespace std_
+{
+
+namespace detail
+{
+
+struct context_frame
+{
+    const context_frame* next;
+    std::size_t size;
+
+    const char* text() const noexcept
+    {
+        return reinterpret_cast<const char*>(this + 1);
+    }
+};
+
+const context_frame* push_context_frame(const context_frame* next,
+                                        const char* text,
+                                        std::size_t size) noexcept;
+
+class context_writer
+{
+public:
+    static constexpr std::size_t capacity = 512;
+
+    void append(std::string_view s) noexcept
+    {
+        const std::size_t n = s.size() < capacity - size_ ? s.size() : capacity - size_;
+        std::memcpy(buf_ + size_, s.data(), n);
+        size_ += n;
+    }
+
+    void append(char c) noexcept
+    {
+        if (size_ < capacity)
+        {
+            buf_[size_++] = c;
+        }
+    }
+
+    template <class N>
+    typename std::enable_if<std::is_arithmetic<N>::value && !std::is_same<N, bool>::value
+                            && !std::is_same<N, char>::value>::type
+    append(N n) noexcept
+    {
+        auto res = std::to_chars(buf_ + size_, buf_ + capacity, n);
+        if (res.ec == std::errc())
+        {
+            size_ = static_cast<std::size_t>(res.ptr - buf_);
+        }
+    }
+
+    void append(bool b) noexcept
+    {
+        append(b ? std::string_view("true") : std::string_view("false"));
+    }
+
+    void append(const char* s) noexcept
+    {
+        append(std::string_view(s != nullptr ? s : "(null)"));
+    }
+
+    void append(const std::string& s) noexcept
+    {
+        append(std::string_view(s));
+    }
+
+    const char* data() const noexcept
+    {
+        return buf_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+private:
+    char buf_[capacity];
+    std::size_t size_ = 0;
+};
+
+inline void format_context(context_writer& out, std::string_view fmt)
+{
+    for (std::size_t i = 0; i < fmt.size(); ++i)
+    {
+        if ((fmt[i] == '{' || fmt[i] == '}') && i + 1 < fmt.size() && fmt[i + 1] == fmt[i])
+        {
+            ++i;
+        }
+        out.append(fmt[i]);
+    }
+}
+
+template <class Arg, class... Args>
+void format_context(context_writer& out, std::string_view fmt, const Arg& arg, const Args&... args)
+{
+    for (std::size_t i = 0; i < fmt.size(); ++i)
+    {
+        if (fmt[i] == '{' && i + 1 < fmt.size())
+        {
+            if (fmt[i + 1] == '}')
+            {
+                out.append(arg);
+                format_context(out, fmt.substr(i + 2), args...);
+                return;
+            }
+            if (fmt[i + 1] == '{')
+            {
+                ++i;
+            }
+        }
+        else if (fmt[i] == '}' && i + 1 < fmt.size() && fmt[i + 1] == '}')
+        {
+            ++i;
+        }
+        out.append(fmt[i]);
+    }
+}
+
+}  // namespace detail
+
+class context_arena
+{
+public:
+    static context_arena& local() noexcept;
+
+    context_arena() noexcept = default;
+    context_arena(const context_arena&) = delete;
+    context_arena& operator=(const context_arena&) = delete;
+    ~context_arena();
+
+    void* allocate(std::size_t bytes, std::size_t align) noexcept;
+
+    std::size_t mark() const noexcept
+    {
+        return used_;
+    }
+
+    void rewind(std::size_t mark) noexcept;
+
+    void reset() noexcept
+    {
+        rewind(0);
+    }
+
+    std::size_t bytes_used() const noexcept
+    {
+        return used_;
+    }
+
+private:
+    struct block;
+
+    block* head_ = nullptr;
+    block* current_ = nullptr;
+    std::size_t offset_ = 0;
+    std::size_t used_ = 0;
+};
+
+class context_scope
+{
+public:
+    context_scope() noexcept : arena_(context_arena::local()), mark_(arena_.mark()) {}
+
+    context_scope(const context_scope&) = delete;
+    context_scope& operator=(const context_scope&) = delete;
+
+    ~context_scope()
+    {
+        arena_.rewind(mark_);
+    }
+
+private:
+    context_arena& arena_;
+    std::size_t mark_;
+};
+
+class error_context
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        constexpr iterator() noexcept = default;
+
+        std::string_view operator*() const noexcept
+        {
+            return std::string_view(frame_->text(), frame_->size);
+        }
+
+        iterator& operator++() noexcept
+        {
+            frame_ = frame_->next;
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator& rhs) const noexcept
+        {
+            return frame_ == rhs.frame_;
+        }
+
+        bool operator!=(const iterator& rhs) const noexcept
+        {
+            return frame_ != rhs.frame_;
+        }
+
+    private:
+        friend class error_context;
+
+        explicit constexpr iterator(const detail::context_frame* f) noexcept : frame_(f) {}
+
+        const detail::context_frame* frame_ = nullptr;
+    };
+
+    constexpr error_context() noexcept = default;
+
+    template <class... Args>
+    explicit error_context(std::string_view fmt, const Args&... args) noexcept
+        : top_(make_frame(nullptr, fmt, args...))
+    {
+    }
+
+    template <class... Args>
+    error_context with_context(std::string_view fmt, const Args&... args) const noexcept
+    {
+        error_context ctx;
+        ctx.top_ = make_frame(top_, fmt, args...);
+        return ctx;
+    }
+
+    bool empty() const noexcept
+    {
+        return top_ == nullptr;
+    }
+
+    // Outermost context first; the originating message is last.
+    iterator begin() const noexcept
+    {
+        return iterator(top_);
+    }
+
+    iterator end() const noexcept
+    {
+        return iterator();
+    }
+
+    std::string_view message() const noexcept
+    {
+        return top_ != nullptr ? *begin() : std::string_view();
+    }
+
+    std::string_view root_cause() const noexcept
+    {
+        const detail::context_frame* f = top_;
+        while (f != nullptr && f->next != nullptr)
+        {
+            f = f->next;
+        }
+        return f != nullptr ? std::string_view(f->text(), f->size) : std::string_view();
+    }
+
+    std::string to_string(std::string_view separator = ": ") const
+    {
+        std::string out;
+        for (auto it = begin(); it != end(); ++it)
+        {
+            if (it != begin())
+            {
+                out.append(separator.data(), separator.size());
+            }
+            out.append((*it).data(), (*it).size());
+        }
+        return out;
+    }
+
+    bool operator==(const error_context& rhs) const noexcept
+    {
+        auto a = begin();
+        auto b = rhs.begin();
+        for (; a != end() && b != rhs.end(); ++a, ++b)
+        {
+            if (*a != *b)
+            {
+                return false;
+            }
+        }
+        return a == end() && b == rhs.end();
+    }
+
+    bool operator!=(const error_context& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    template <class... Args>
+    static const detail::context_frame* make_frame(const detail::context_frame* next,
+                                                   std::string_view fmt,
+                                                   const Args&... args) noexcept
+    {
+        detail::context_writer out;
+        detail::format_context(out, fmt, args...);
+        const detail::context_frame* frame =
+            detail::push_context_frame(next, out.data(), out.size());
+        return frame != nullptr ? frame : next;
+    }
+
+    const detail::context_frame* top_ = nullptr;
+};
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_ERROR_CONTEXT_HPP_w6n1hz
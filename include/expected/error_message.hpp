@@ -0,0 +1,301 @@
+#ifndef LIB_STD_EXPECTED_ERROR_MESSAGE_HPP_h3t6ya
+#define LIB_STD_EXPECTED_ERROR_MESSAGE_HPP_h3t6ya
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__cpp_consteval) && defined(__cpp_constexpr_dynamic_alloc)
+#    define STD_EXPECTED_ERROR_MESSAGE_CONSTEVAL consteval
+#else
+#    define STD_EXPECTED_ERROR_MESSAGE_CONSTEVAL constexpr
+#endif
+
+// Fixed-size error message for use as E. Text up to the inline capacity is stored in the object
+// itself; longer text either spills to the heap or is truncated, depending on the overflow
+// policy. String literals passed through from_literal() are referenced, never copied.
+
+namespace std_
+{
+
+enum class overflow_policy : unsigned char
+{
+    spill,
+    truncate
+};
+
+template <std::size_t Capacity = 64, overflow_policy Overflow = overflow_policy::spill>
+class basic_error_message
+{
+    static_assert(Capacity >= 32 && Capacity <= 256, "Capacity must be in [32, 256] bytes");
+
+    enum kind : unsigned char
+    {
+        kind_inline,
+        kind_literal,
+        kind_heap
+    };
+
+    // Both members start with the same two bytes, so kind can be read through either one
+    // regardless of which member is active. Only external_rep is ever active during constant
+    // evaluation, which is where the tag is read from.
+    struct inline_rep
+    {
+        unsigned char kind;
+        unsigned char size;
+        char data[Capacity - 2];
+    };
+
+    struct external_rep
+    {
+        unsigned char kind;
+        unsigned char size;
+        const char* ptr;
+        std::size_t len;
+    };
+
+    union rep
+    {
+        inline_rep inl;
+        external_rep ext;
+
+        constexpr rep() noexcept : inl{kind_inline, 0, {}} {}
+
+        constexpr rep(unsigned char k, const char* p, std::size_t n) noexcept : ext{k, 0, p, n}
+        {
+        }
+    };
+
+public:
+    static constexpr std::size_t inline_capacity = Capacity - 3;
+
+    constexpr basic_error_message() noexcept : rep_(kind_literal, "", 0) {}
+
+    // Copies the text up to its first NUL (or all N chars if there is none), like any other
+    // runtime string; char buffers on the stack are safe to pass.
+    template <std::size_t N>
+    basic_error_message(const char (&text)[N])
+    {
+        assign(std::string_view(text, bounded_length(text, N)));
+    }
+
+    // References a string literal instead of copying it. The argument has to be a constant
+    // expression, so a stack buffer or a mutable array is rejected at compile time.
+    template <std::size_t N>
+    static STD_EXPECTED_ERROR_MESSAGE_CONSTEVAL basic_error_message from_literal(
+        const char (&literal)[N]) noexcept
+    {
+        return basic_error_message(literal_tag{}, literal, std::char_traits<char>::length(literal));
+    }
+
+    explicit basic_error_message(std::string_view text)
+    {
+        assign(text);
+    }
+
+    explicit basic_error_message(const std::string& text)
+        : basic_error_message(std::string_view(text))
+    {
+    }
+
+    basic_error_message(const basic_error_message& rhs)
+    {
+        if (rhs.is_heap())
+        {
+            assign(rhs.view());
+        }
+        else
+        {
+            std::memcpy(static_cast<void*>(&rep_), &rhs.rep_, sizeof(rep_));
+        }
+    }
+
+    basic_error_message(basic_error_message&& rhs) noexcept
+    {
+        std::memcpy(static_cast<void*>(&rep_), &rhs.rep_, sizeof(rep_));
+        if (rhs.is_heap())
+        {
+            ::new (static_cast<void*>(&rhs.rep_)) rep(kind_literal, "", 0);
+        }
+    }
+
+    basic_error_message& operator=(const basic_error_message& rhs)
+    {
+        if (this != &rhs)
+        {
+            basic_error_message tmp(rhs);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    basic_error_message& operator=(basic_error_message&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            release();
+            std::memcpy(static_cast<void*>(&rep_), &rhs.rep_, sizeof(rep_));
+            if (rhs.is_heap())
+            {
+                ::new (static_cast<void*>(&rhs.rep_)) rep(kind_literal, "", 0);
+            }
+        }
+        return *this;
+    }
+
+#if defined(__cpp_constexpr_dynamic_alloc)
+    constexpr ~basic_error_message()
+#else
+    ~basic_error_message()
+#endif
+    {
+        if (is_heap())
+        {
+            delete[] rep_.ext.ptr;
+        }
+    }
+
+    constexpr const char* data() const noexcept
+    {
+        return kind() == kind_inline ? rep_.inl.data : rep_.ext.ptr;
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return kind() == kind_inline ? rep_.inl.size : rep_.ext.len;
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // Literals and owned text are always NUL-terminated.
+    constexpr const char* c_str() const noexcept
+    {
+        return data();
+    }
+
+    constexpr std::string_view view() const noexcept
+    {
+        return std::string_view(data(), size());
+    }
+
+    constexpr operator std::string_view() const noexcept
+    {
+        return view();
+    }
+
+    std::string str() const
+    {
+        return std::string(data(), size());
+    }
+
+    constexpr bool is_literal() const noexcept
+    {
+        return kind() == kind_literal;
+    }
+
+    constexpr bool is_inline() const noexcept
+    {
+        return kind() == kind_inline;
+    }
+
+    constexpr bool is_heap() const noexcept
+    {
+        return kind() == kind_heap;
+    }
+
+    friend constexpr bool operator==(const basic_error_message& lhs,
+                                     const basic_error_message& rhs) noexcept
+    {
+        return lhs.view() == rhs.view();
+    }
+
+    friend constexpr bool operator!=(const basic_error_message& lhs,
+                                     const basic_error_message& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator==(const basic_error_message& lhs, std::string_view rhs) noexcept
+    {
+        return lhs.view() == rhs;
+    }
+
+    friend constexpr bool operator!=(const basic_error_message& lhs, std::string_view rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    template <std::size_t N>
+    friend constexpr bool operator==(const basic_error_message& lhs, const char (&rhs)[N]) noexcept
+    {
+        return lhs.view() == std::string_view(rhs, bounded_length(rhs, N));
+    }
+
+    template <std::size_t N>
+    friend constexpr bool operator!=(const basic_error_message& lhs, const char (&rhs)[N]) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    struct literal_tag
+    {
+    };
+
+    constexpr basic_error_message(literal_tag, const char* literal, std::size_t n) noexcept
+        : rep_(kind_literal, literal, n)
+    {
+    }
+
+    static constexpr std::size_t bounded_length(const char* text, std::size_t n) noexcept
+    {
+        const char* nul = std::char_traits<char>::find(text, n, '\0');
+        return nul != nullptr ? static_cast<std::size_t>(nul - text) : n;
+    }
+
+    constexpr unsigned char kind() const noexcept
+    {
+        return rep_.ext.kind;
+    }
+
+    void assign(std::string_view text)
+    {
+        if (text.size() <= inline_capacity || Overflow == overflow_policy::truncate)
+        {
+            const std::size_t n = text.size() <= inline_capacity ? text.size() : inline_capacity;
+            ::new (static_cast<void*>(&rep_)) rep();
+            std::memcpy(rep_.inl.data, text.data(), n);
+            rep_.inl.data[n] = '\0';
+            rep_.inl.size = static_cast<unsigned char>(n);
+        }
+        else
+        {
+            char* p = new char[text.size() + 1];
+            std::memcpy(p, text.data(), text.size());
+            p[text.size()] = '\0';
+            ::new (static_cast<void*>(&rep_)) rep(kind_heap, p, text.size());
+        }
+    }
+
+    void release() noexcept
+    {
+        if (is_heap())
+        {
+            delete[] rep_.ext.ptr;
+        }
+    }
+
+    rep rep_;
+};
+
+using error_message = basic_error_message<>;
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_ERROR_MESSAGE_HPP_h3t6ya
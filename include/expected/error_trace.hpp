@@ -0,0 +1,204 @@
+#ifndef LIB_STD_EXPECTED_ERROR_TRACE_HPP_p2v7kd
+#define LIB_STD_EXPECTED_ERROR_TRACE_HPP_p2v7kd
+
+#include <expected/expected.hpp>
+#include <expected/source_location.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Opt-in origin tracking for error values. With STD_EXPECTED_ERROR_TRACE defined,
+// std_::traced<E> carries the source_location of the make_traced_unexpected() call and, for one
+// in every error_trace::sample_rate() constructions on a thread, a captured backtrace. Without
+// it, traced<E> is E itself and make_traced_unexpected() is make_unexpected().
+
+namespace std_
+{
+
+namespace error_trace
+{
+
+struct backtrace_view
+{
+    void* const* frames;
+    std::size_t size;
+
+    bool empty() const noexcept
+    {
+        return size == 0;
+    }
+};
+
+// 0 disables backtrace capture; 1 captures on every traced construction.
+void set_sample_rate(std::uint32_t every_n) noexcept;
+std::uint32_t sample_rate() noexcept;
+
+void write_backtrace(const backtrace_view& trace, int fd) noexcept;
+
+}  // namespace error_trace
+
+namespace detail
+{
+
+struct backtrace_record;
+
+extern std::atomic<std::uint32_t> backtrace_sample_rate;
+
+backtrace_record* capture_backtrace() noexcept;
+void retain_backtrace(backtrace_record* record) noexcept;
+void release_backtrace(backtrace_record* record) noexcept;
+error_trace::backtrace_view view_backtrace(const backtrace_record* record) noexcept;
+
+inline backtrace_record* sample_backtrace() noexcept
+{
+    // Every construction pays one relaxed load and a thread-local increment; only one in
+    // `rate` reaches the out-of-line capture.
+    const std::uint32_t rate = backtrace_sample_rate.load(std::memory_order_relaxed);
+    if (rate == 0)
+    {
+        return nullptr;
+    }
+
+    static thread_local std::uint32_t counter = 0;
+    if (++counter < rate)
+    {
+        return nullptr;
+    }
+    counter = 0;
+    return capture_backtrace();
+}
+
+}  // namespace detail
+
+#if defined(STD_EXPECTED_ERROR_TRACE)
+
+template <class E>
+class traced
+{
+    static_assert(!std::is_reference<E>::value, "E must not be a reference");
+
+public:
+    template <class... Args,
+              typename std::enable_if<std::is_constructible<E, Args...>::value, int>::type = 0>
+    explicit traced(source_location loc, Args&&... args) noexcept(
+        std::is_nothrow_constructible<E, Args...>::value)
+        : err_(std::forward<Args>(args)...), loc_(loc), trace_(detail::sample_backtrace())
+    {
+    }
+
+    traced(const traced& rhs) : err_(rhs.err_), loc_(rhs.loc_), trace_(rhs.trace_)
+    {
+        detail::retain_backtrace(trace_);
+    }
+
+    traced(traced&& rhs) noexcept(std::is_nothrow_move_constructible<E>::value)
+        : err_(std::move(rhs.err_)), loc_(rhs.loc_), trace_(rhs.trace_)
+    {
+        rhs.trace_ = nullptr;
+    }
+
+    traced& operator=(const traced& rhs)
+    {
+        if (this != &rhs)
+        {
+            err_ = rhs.err_;
+            loc_ = rhs.loc_;
+            detail::retain_backtrace(rhs.trace_);
+            detail::release_backtrace(trace_);
+            trace_ = rhs.trace_;
+        }
+        return *this;
+    }
+
+    traced& operator=(traced&& rhs) noexcept(std::is_nothrow_move_assignable<E>::value)
+    {
+        if (this != &rhs)
+        {
+            err_ = std::move(rhs.err_);
+            loc_ = rhs.loc_;
+            detail::release_backtrace(trace_);
+            trace_ = rhs.trace_;
+            rhs.trace_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~traced()
+    {
+        detail::release_backtrace(trace_);
+    }
+
+    const E& error() const& noexcept
+    {
+        return err_;
+    }
+
+    E& error() & noexcept
+    {
+        return err_;
+    }
+
+    E&& error() && noexcept
+    {
+        return std::move(err_);
+    }
+
+    const source_location& location() const noexcept
+    {
+        return loc_;
+    }
+
+    error_trace::backtrace_view backtrace() const noexcept
+    {
+        return detail::view_backtrace(trace_);
+    }
+
+    // The origin is diagnostic metadata; two errors compare by payload only.
+    template <class E2>
+    bool operator==(const traced<E2>& rhs) const
+    {
+        return err_ == rhs.error();
+    }
+
+    template <class E2>
+    bool operator!=(const traced<E2>& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    E err_;
+    source_location loc_;
+    detail::backtrace_record* trace_;
+};
+
+template <class E>
+unexpected<traced<typename std::decay<E>::type>> make_traced_unexpected(
+    E&& e,
+    source_location loc = source_location::current())
+{
+    return unexpected<traced<typename std::decay<E>::type>>(
+        detail::in_place, loc, std::forward<E>(e));
+}
+
+#else
+
+template <class E>
+using traced = E;
+
+template <class E>
+constexpr unexpected<typename std::decay<E>::type> make_traced_unexpected(
+    E&& e,
+    source_location = source_location::current())
+{
+    return unexpected<typename std::decay<E>::type>(std::forward<E>(e));
+}
+
+#endif
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_ERROR_TRACE_HPP_p2v7kd
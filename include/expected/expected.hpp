@@ -7,6 +7,83 @@
 #include <type_traits>
 #include <utility>
 
+#if defined(STD_EXPECTED_EXTERN_TEMPLATES)
+#    include <string>
+#    include <system_error>
+#endif
+
+// With STD_EXPECTED_USE_STD (CMake: ENABLE_STD_EXPECTED) and a standard library whose
+// std::expected has the monadic operations (__cpp_lib_expected >= 202211L), std_::expected,
+// std_::unexpected and std_::bad_expected_access are aliases of the std:: types instead of the
+// polyfill below, so values cross API boundaries without any conversion. Otherwise the option
+// is ignored. STD_EXPECTED_IS_STD tells which one is in use.
+#if defined(STD_EXPECTED_USE_STD) && defined(__has_include)
+#    if __has_include(<version>)
+#        include <version>
+#    endif
+#    if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202211L
+#        include <expected>
+#        include <memory>
+#        define STD_EXPECTED_IS_STD 1
+#    endif
+#endif
+#if !defined(STD_EXPECTED_IS_STD)
+#    define STD_EXPECTED_IS_STD 0
+#endif
+
+#if defined(STD_EXPECTED_TELEMETRY) && !STD_EXPECTED_IS_STD
+#    include <expected/telemetry.hpp>
+#endif
+
+#if STD_EXPECTED_IS_STD
+
+namespace std_
+{
+
+using std::bad_expected_access;
+using std::expected;
+using std::unexpected;
+
+// The parts of the polyfill's detail namespace that the other headers build on.
+namespace detail
+{
+
+template <class T>
+struct is_expected_impl : std::false_type
+{
+};
+
+template <class T, class E>
+struct is_expected_impl<std::expected<T, E>> : std::true_type
+{
+};
+
+template <class T>
+struct is_expected : is_expected_impl<std::decay_t<T>>
+{
+};
+
+template <class T>
+struct remove_cvref
+{
+    using type = std::remove_cvref_t<T>;
+};
+
+using std::in_place;
+using std::in_place_t;
+
+template <class T>
+constexpr T* addressof(T& arg) noexcept
+{
+    return std::addressof(arg);
+}
+
+}  // namespace detail
+
+}  // namespace std_
+
+#else
+
 namespace std_
 {
 
@@ -60,7 +137,13 @@ struct in_place_t
     explicit in_place_t() = default;
 };
 
+// Inline where available: a namespace-scope static gives every TU its own copy and cannot be
+// referenced from exported templates in a module interface.
+#if defined(__cpp_inline_variables)
+inline constexpr in_place_t in_place{};
+#else
 static constexpr in_place_t in_place{};
+#endif
 
 template <class T>
 struct in_place_type_t
@@ -90,6 +173,36 @@ constexpr T* addressof(T& arg) noexcept
     return reinterpret_cast<T*>(&const_cast<char&>(reinterpret_cast<const volatile char&>(arg)));
 }
 
+struct construct_from_t
+{
+    explicit construct_from_t() = default;
+};
+
+// Telemetry hooks, see telemetry.hpp. Without STD_EXPECTED_TELEMETRY they are empty.
+#if defined(STD_EXPECTED_TELEMETRY)
+template <class E>
+constexpr void note_error_construct(const source_location& site = source_location()) noexcept
+{
+    note_error<E>(telemetry::event::construct, site);
+}
+
+template <class E>
+constexpr void note_error_transition() noexcept
+{
+    note_error<E>(telemetry::event::transition);
+}
+#else
+template <class E>
+constexpr void note_error_construct() noexcept
+{
+}
+
+template <class E>
+constexpr void note_error_transition() noexcept
+{
+}
+#endif
+
 template <bool TriviallyDestructible>
 struct expected_destructor_base
 {
@@ -133,6 +246,19 @@ struct expected_storage_base : expected_destructor_base<false>
     {
     }
 
+    template <class Rhs>
+    constexpr expected_storage_base(construct_from_t, Rhs&& rhs) : base(rhs.has_val)
+    {
+        if (rhs.has_val)
+        {
+            ::new (static_cast<void*>(detail::addressof(val))) T(std::forward<Rhs>(rhs).val);
+        }
+        else
+        {
+            ::new (static_cast<void*>(detail::addressof(err))) E(std::forward<Rhs>(rhs).err);
+        }
+    }
+
     ~expected_storage_base()
     {
         if (this->has_val)
@@ -167,6 +293,19 @@ struct expected_storage_base<T, E, true> : expected_destructor_base<true>
         : base(false), err(std::forward<Args>(args)...)
     {
     }
+
+    template <class Rhs>
+    constexpr expected_storage_base(construct_from_t, Rhs&& rhs) : base(rhs.has_val)
+    {
+        if (rhs.has_val)
+        {
+            ::new (static_cast<void*>(detail::addressof(val))) T(std::forward<Rhs>(rhs).val);
+        }
+        else
+        {
+            ::new (static_cast<void*>(detail::addressof(err))) E(std::forward<Rhs>(rhs).err);
+        }
+    }
 };
 
 template <class E, bool = std::is_trivially_destructible<E>::value>
@@ -222,22 +361,242 @@ template <class E>
 using expected_void_storage = expected_void_storage_base<E>;
 
 
+template <class New, class Old, class... Args>
+void reinit_expected(New& newval, Old& oldval, Args&&... args)
+{
+    if (std::is_nothrow_constructible<New, Args...>::value)
+    {
+        oldval.~Old();
+        ::new (static_cast<void*>(detail::addressof(newval))) New(std::forward<Args>(args)...);
+    }
+    else if (std::is_nothrow_move_constructible<New>::value)
+    {
+        New tmp(std::forward<Args>(args)...);
+        oldval.~Old();
+        ::new (static_cast<void*>(detail::addressof(newval))) New(std::move(tmp));
+    }
+    else
+    {
+        Old tmp(std::move(oldval));
+        oldval.~Old();
+        try
+        {
+            ::new (static_cast<void*>(detail::addressof(newval))) New(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            ::new (static_cast<void*>(detail::addressof(oldval))) Old(std::move(tmp));
+            throw;
+        }
+    }
+}
+
+template <class Self, class Rhs>
+void assign_expected(Self& self, Rhs&& rhs)
+{
+    if (self.has_val && rhs.has_val)
+    {
+        self.val = std::forward<Rhs>(rhs).val;
+    }
+    else if (!self.has_val && !rhs.has_val)
+    {
+        self.err = std::forward<Rhs>(rhs).err;
+    }
+    else if (self.has_val)
+    {
+        note_error_transition<decltype(self.err)>();
+        reinit_expected(self.err, self.val, std::forward<Rhs>(rhs).err);
+        self.has_val = false;
+    }
+    else
+    {
+        reinit_expected(self.val, self.err, std::forward<Rhs>(rhs).val);
+        self.has_val = true;
+    }
+}
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 202002L
+
+// Constrained special members can be defaulted (and so stay trivial) or user-provided in the
+// same class, which collapses the four-level copy / move / assign chain used for C++11 into one
+// base per expected. Every expected type instantiates its whole base chain, so this is most of
+// the per-type frontend cost.
+
 template <class T, class E>
+struct expected_base : expected_storage<T, E>
+{
+    using expected_storage<T, E>::expected_storage;
+
+    static constexpr bool trivial_copy = std::is_trivially_copy_constructible<T>::value
+                                         && std::is_trivially_copy_constructible<E>::value;
+    static constexpr bool trivial_move = std::is_trivially_move_constructible<T>::value
+                                         && std::is_trivially_move_constructible<E>::value;
+    static constexpr bool trivial_copy_assign =
+        trivial_copy && std::is_trivially_copy_assignable<T>::value
+        && std::is_trivially_destructible<T>::value && std::is_trivially_copy_assignable<E>::value
+        && std::is_trivially_destructible<E>::value;
+    static constexpr bool trivial_move_assign =
+        trivial_move && std::is_trivially_move_assignable<T>::value
+        && std::is_trivially_destructible<T>::value && std::is_trivially_move_assignable<E>::value
+        && std::is_trivially_destructible<E>::value;
+
+    expected_base(const expected_base&)
+        requires trivial_copy
+    = default;
+
+    expected_base(const expected_base& rhs)
+        requires(!trivial_copy && std::is_copy_constructible<T>::value
+                 && std::is_copy_constructible<E>::value)
+        : expected_storage<T, E>(construct_from_t{}, rhs)
+    {
+    }
+
+    // Without an eligible move constructor, rvalues fall back to the copy constructor.
+    expected_base(expected_base&&)
+        requires trivial_move
+    = default;
+
+    expected_base(expected_base&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value
+                                                && std::is_nothrow_move_constructible<E>::value)
+        requires(!trivial_move && std::is_move_constructible<T>::value
+                 && std::is_move_constructible<E>::value)
+        : expected_storage<T, E>(construct_from_t{}, std::move(rhs))
+    {
+    }
+
+    expected_base& operator=(const expected_base&)
+        requires trivial_copy_assign
+    = default;
+
+    expected_base& operator=(const expected_base& rhs)
+        requires(!trivial_copy_assign && std::is_copy_assignable<T>::value
+                 && std::is_copy_constructible<T>::value && std::is_copy_assignable<E>::value
+                 && std::is_copy_constructible<E>::value)
+    {
+        assign_expected(*this, rhs);
+        return *this;
+    }
+
+    expected_base& operator=(expected_base&&)
+        requires trivial_move_assign
+    = default;
+
+    expected_base& operator=(expected_base&& rhs) noexcept(
+        std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value
+        && std::is_nothrow_move_constructible<E>::value
+        && std::is_nothrow_move_assignable<E>::value)
+        requires(!trivial_move_assign && std::is_move_assignable<T>::value
+                 && std::is_move_constructible<T>::value && std::is_move_assignable<E>::value
+                 && std::is_move_constructible<E>::value)
+    {
+        assign_expected(*this, std::move(rhs));
+        return *this;
+    }
+};
+
+template <class E>
+struct expected_void_base : expected_void_storage<E>
+{
+    using expected_void_storage<E>::expected_void_storage;
+
+    expected_void_base() = default;
+
+    expected_void_base(const expected_void_base& rhs)
+        requires std::is_copy_constructible<E>::value
+        : expected_void_storage<E>()
+    {
+        if (!rhs.has_val)
+        {
+            ::new (static_cast<void*>(detail::addressof(this->err))) E(rhs.err);
+            this->has_val = false;
+        }
+    }
+
+    expected_void_base(expected_void_base&& rhs) noexcept(
+        std::is_nothrow_move_constructible<E>::value)
+        requires std::is_move_constructible<E>::value
+        : expected_void_storage<E>()
+    {
+        if (!rhs.has_val)
+        {
+            ::new (static_cast<void*>(detail::addressof(this->err))) E(std::move(rhs.err));
+            this->has_val = false;
+        }
+    }
+
+    expected_void_base& operator=(const expected_void_base& rhs)
+        requires(std::is_copy_assignable<E>::value && std::is_copy_constructible<E>::value)
+    {
+        assign_void(rhs.has_val, rhs.err);
+        return *this;
+    }
+
+    expected_void_base& operator=(expected_void_base&& rhs) noexcept(
+        std::is_nothrow_move_constructible<E>::value && std::is_nothrow_move_assignable<E>::value)
+        requires(std::is_move_assignable<E>::value && std::is_move_constructible<E>::value)
+    {
+        assign_void(rhs.has_val, std::move(rhs.err));
+        return *this;
+    }
+
+private:
+    template <class Err>
+    void assign_void(bool rhs_has_val, Err&& rhs_err)
+    {
+        if (this->has_val && !rhs_has_val)
+        {
+            note_error_transition<E>();
+            ::new (static_cast<void*>(detail::addressof(this->err))) E(std::forward<Err>(rhs_err));
+            this->has_val = false;
+        }
+        else if (!this->has_val && rhs_has_val)
+        {
+            this->err.~E();
+            this->has_val = true;
+        }
+        else if (!this->has_val)
+        {
+            this->err = std::forward<Err>(rhs_err);
+        }
+    }
+};
+
+#else
+
+template <class T,
+          class E,
+          bool = std::is_trivially_copy_constructible<T>::value
+                 && std::is_trivially_copy_constructible<E>::value,
+          bool = std::is_copy_constructible<T>::value && std::is_copy_constructible<E>::value>
 struct expected_copy_base : expected_storage<T, E>
 {
     using expected_storage<T, E>::expected_storage;
 
-    expected_copy_base() = default;
-    expected_copy_base(const expected_copy_base&) = default;
+    expected_copy_base(const expected_copy_base& rhs)
+        : expected_storage<T, E>(construct_from_t{}, rhs)
+    {
+    }
+
     expected_copy_base(expected_copy_base&&) = default;
     expected_copy_base& operator=(const expected_copy_base&) = default;
     expected_copy_base& operator=(expected_copy_base&&) = default;
+};
+
+template <class T, class E, bool Copyable>
+struct expected_copy_base<T, E, true, Copyable> : expected_storage<T, E>
+{
+    using expected_storage<T, E>::expected_storage;
+};
+
+template <class T, class E>
+struct expected_copy_base<T, E, false, false> : expected_storage<T, E>
+{
+    using expected_storage<T, E>::expected_storage;
 
-    template <bool Dummy = true,
-              class = typename std::enable_if<Dummy
-                                              && (!std::is_copy_constructible<T>::value
-                                                  || !std::is_copy_constructible<E>::value)>::type>
     expected_copy_base(const expected_copy_base&) = delete;
+    expected_copy_base(expected_copy_base&&) = default;
+    expected_copy_base& operator=(const expected_copy_base&) = default;
+    expected_copy_base& operator=(expected_copy_base&&) = default;
 };
 
 template <class E>
@@ -268,22 +627,42 @@ struct expected_void_copy_base : expected_void_storage<E>
     expected_void_copy_base(const expected_void_copy_base&) = delete;
 };
 
-template <class T, class E>
+template <class T,
+          class E,
+          bool = std::is_trivially_move_constructible<T>::value
+                 && std::is_trivially_move_constructible<E>::value,
+          bool = std::is_move_constructible<T>::value && std::is_move_constructible<E>::value>
 struct expected_move_base : expected_copy_base<T, E>
 {
     using expected_copy_base<T, E>::expected_copy_base;
 
-    expected_move_base() = default;
     expected_move_base(const expected_move_base&) = default;
-    expected_move_base(expected_move_base&&) = default;
+
+    expected_move_base(expected_move_base&& rhs) noexcept(
+        std::is_nothrow_move_constructible<T>::value
+        && std::is_nothrow_move_constructible<E>::value)
+        : expected_copy_base<T, E>(construct_from_t{}, std::move(rhs))
+    {
+    }
+
     expected_move_base& operator=(const expected_move_base&) = default;
     expected_move_base& operator=(expected_move_base&&) = default;
+};
 
-    template <bool Dummy = true,
-              class = typename std::enable_if<Dummy
-                                              && (!std::is_move_constructible<T>::value
-                                                  || !std::is_move_constructible<E>::value)>::type>
-    expected_move_base(expected_move_base&&) = delete;
+template <class T, class E, bool Movable>
+struct expected_move_base<T, E, true, Movable> : expected_copy_base<T, E>
+{
+    using expected_copy_base<T, E>::expected_copy_base;
+};
+
+template <class T, class E>
+struct expected_move_base<T, E, false, false> : expected_copy_base<T, E>
+{
+    using expected_copy_base<T, E>::expected_copy_base;
+
+    // No move constructor is declared, so rvalues fall back to the copy constructor.
+    expected_move_base(const expected_move_base&) = default;
+    expected_move_base& operator=(const expected_move_base&) = default;
 };
 
 template <class E>
@@ -315,24 +694,47 @@ struct expected_void_move_base : expected_void_copy_base<E>
     expected_void_move_base(expected_void_move_base&&) = delete;
 };
 
-template <class T, class E>
+template <class T,
+          class E,
+          bool = std::is_trivially_copy_assignable<T>::value
+                 && std::is_trivially_copy_constructible<T>::value
+                 && std::is_trivially_destructible<T>::value
+                 && std::is_trivially_copy_assignable<E>::value
+                 && std::is_trivially_copy_constructible<E>::value
+                 && std::is_trivially_destructible<E>::value,
+          bool = std::is_copy_assignable<T>::value && std::is_copy_constructible<T>::value
+                 && std::is_copy_assignable<E>::value && std::is_copy_constructible<E>::value>
 struct expected_copy_assign_base : expected_move_base<T, E>
 {
     using expected_move_base<T, E>::expected_move_base;
 
-    expected_copy_assign_base() = default;
     expected_copy_assign_base(const expected_copy_assign_base&) = default;
     expected_copy_assign_base(expected_copy_assign_base&&) = default;
-    expected_copy_assign_base& operator=(const expected_copy_assign_base&) = default;
+
+    expected_copy_assign_base& operator=(const expected_copy_assign_base& rhs)
+    {
+        assign_expected(*this, rhs);
+        return *this;
+    }
+
     expected_copy_assign_base& operator=(expected_copy_assign_base&&) = default;
+};
 
-    template <bool Dummy = true,
-              class = typename std::enable_if<Dummy
-                                              && (!std::is_copy_assignable<T>::value
-                                                  || !std::is_copy_constructible<T>::value
-                                                  || !std::is_copy_assignable<E>::value
-                                                  || !std::is_copy_constructible<E>::value)>::type>
+template <class T, class E, bool Assignable>
+struct expected_copy_assign_base<T, E, true, Assignable> : expected_move_base<T, E>
+{
+    using expected_move_base<T, E>::expected_move_base;
+};
+
+template <class T, class E>
+struct expected_copy_assign_base<T, E, false, false> : expected_move_base<T, E>
+{
+    using expected_move_base<T, E>::expected_move_base;
+
+    expected_copy_assign_base(const expected_copy_assign_base&) = default;
+    expected_copy_assign_base(expected_copy_assign_base&&) = default;
     expected_copy_assign_base& operator=(const expected_copy_assign_base&) = delete;
+    expected_copy_assign_base& operator=(expected_copy_assign_base&&) = default;
 };
 
 template <class E>
@@ -359,6 +761,7 @@ struct expected_void_copy_assign_base : expected_void_move_base<E>
         else if (this->has_val && !rhs.has_val)
         {
             // Success to error
+            note_error_transition<E>();
             ::new (static_cast<void*>(detail::addressof(this->err))) E(rhs.err);
             this->has_val = false;
         }
@@ -378,24 +781,49 @@ struct expected_void_copy_assign_base : expected_void_move_base<E>
     expected_void_copy_assign_base& operator=(const expected_void_copy_assign_base&) = delete;
 };
 
-template <class T, class E>
+template <class T,
+          class E,
+          bool = std::is_trivially_move_assignable<T>::value
+                 && std::is_trivially_move_constructible<T>::value
+                 && std::is_trivially_destructible<T>::value
+                 && std::is_trivially_move_assignable<E>::value
+                 && std::is_trivially_move_constructible<E>::value
+                 && std::is_trivially_destructible<E>::value,
+          bool = std::is_move_assignable<T>::value && std::is_move_constructible<T>::value
+                 && std::is_move_assignable<E>::value && std::is_move_constructible<E>::value>
 struct expected_move_assign_base : expected_copy_assign_base<T, E>
 {
     using expected_copy_assign_base<T, E>::expected_copy_assign_base;
 
-    expected_move_assign_base() = default;
     expected_move_assign_base(const expected_move_assign_base&) = default;
     expected_move_assign_base(expected_move_assign_base&&) = default;
     expected_move_assign_base& operator=(const expected_move_assign_base&) = default;
-    expected_move_assign_base& operator=(expected_move_assign_base&&) = default;
 
-    template <bool Dummy = true,
-              class = typename std::enable_if<Dummy
-                                              && (!std::is_move_assignable<T>::value
-                                                  || !std::is_move_constructible<T>::value
-                                                  || !std::is_move_assignable<E>::value
-                                                  || !std::is_move_constructible<E>::value)>::type>
-    expected_move_assign_base& operator=(expected_move_assign_base&&) = delete;
+    expected_move_assign_base& operator=(expected_move_assign_base&& rhs) noexcept(
+        std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value
+        && std::is_nothrow_move_constructible<E>::value
+        && std::is_nothrow_move_assignable<E>::value)
+    {
+        assign_expected(*this, std::move(rhs));
+        return *this;
+    }
+};
+
+template <class T, class E, bool Assignable>
+struct expected_move_assign_base<T, E, true, Assignable> : expected_copy_assign_base<T, E>
+{
+    using expected_copy_assign_base<T, E>::expected_copy_assign_base;
+};
+
+template <class T, class E>
+struct expected_move_assign_base<T, E, false, false> : expected_copy_assign_base<T, E>
+{
+    using expected_copy_assign_base<T, E>::expected_copy_assign_base;
+
+    // No move assignment is declared, so rvalues fall back to copy assignment.
+    expected_move_assign_base(const expected_move_assign_base&) = default;
+    expected_move_assign_base(expected_move_assign_base&&) = default;
+    expected_move_assign_base& operator=(const expected_move_assign_base&) = default;
 };
 
 template <class E>
@@ -423,6 +851,7 @@ struct expected_void_move_assign_base : expected_void_copy_assign_base<E>
         else if (this->has_val && !rhs.has_val)
         {
             // Success to error
+            note_error_transition<E>();
             ::new (static_cast<void*>(detail::addressof(this->err))) E(std::move(rhs.err));
             this->has_val = false;
         }
@@ -448,6 +877,8 @@ using expected_base = expected_move_assign_base<T, E>;
 template <class E>
 using expected_void_base = expected_void_move_assign_base<E>;
 
+#endif
+
 template <class T>
 struct is_nothrow_swappable
 {
@@ -460,6 +891,53 @@ struct is_nothrow_swappable
     static constexpr bool value = noexcept(std::swap(std::declval<T&>(), std::declval<T&>()));
 };
 
+template <class...>
+struct conjunction : std::true_type
+{
+};
+
+template <class B>
+struct conjunction<B> : B
+{
+};
+
+template <class B, class... Bs>
+struct conjunction<B, Bs...> : std::conditional<B::value, conjunction<Bs...>, B>::type
+{
+};
+
+template <class B>
+struct negation : std::integral_constant<bool, !B::value>
+{
+};
+
+// Constraint of the converting constructors from expected<U, G>, where UF and GF are U and G
+// with the constructor's qualification. The checks run in order and stop at the first failure;
+// expected<T, E> itself is rejected first, so ordinary copies and moves, which also deduce
+// these templates, never evaluate the constructibility checks.
+template <class T, class E, class U, class G, class UF, class GF>
+struct converts_from_expected
+    : conjunction<negation<conjunction<std::is_same<T, U>, std::is_same<E, G>>>,
+                  std::is_constructible<T, UF>,
+                  std::is_constructible<E, GF>,
+                  negation<std::is_constructible<T, expected<U, G>&>>,
+                  negation<std::is_constructible<T, expected<U, G>>>,
+                  negation<std::is_constructible<T, const expected<U, G>&>>,
+                  negation<std::is_constructible<T, const expected<U, G>>>,
+                  negation<std::is_convertible<expected<U, G>&, T>>,
+                  negation<std::is_convertible<expected<U, G>, T>>,
+                  negation<std::is_convertible<const expected<U, G>&, T>>,
+                  negation<std::is_convertible<const expected<U, G>, T>>>
+{
+};
+
+template <class UF, class GF, class T, class E>
+struct implicitly_converts
+    : std::integral_constant<bool,
+                             std::is_convertible<UF, T>::value && std::is_convertible<GF, E>::value>
+{
+};
+
 template <class T, class U>
 struct is_same_decayed : std::is_same<typename std::decay<T>::type, typename std::decay<U>::type>
 {
@@ -525,10 +1003,20 @@ public:
         typename std::enable_if<!std::is_same<typename std::decay<Err>::type, unexpected>::value
                                     && std::is_constructible<E, Err&&>::value,
                                 int>::type = 0>
+#if defined(STD_EXPECTED_TELEMETRY)
+    constexpr explicit unexpected(Err&& e,
+                                  source_location site = source_location::current()) noexcept(
+        std::is_nothrow_constructible<E, Err&&>::value)
+        : val_(std::forward<Err>(e))
+    {
+        detail::note_error_construct<E>(site);
+    }
+#else
     constexpr explicit unexpected(Err&& e) noexcept(std::is_nothrow_constructible<E, Err&&>::value)
         : val_(std::forward<Err>(e))
     {
     }
+#endif
 
     template <class... Args,
               typename std::enable_if<std::is_constructible<E, Args...>::value, int>::type = 0>
@@ -536,6 +1024,7 @@ public:
         std::is_nothrow_constructible<E, Args...>::value)
         : val_(std::forward<Args>(args)...)
     {
+        detail::note_error_construct<E>();
     }
 
     template <
@@ -551,6 +1040,7 @@ public:
                                                                Args...>::value)
         : val_(il, std::forward<Args>(args)...)
     {
+        detail::note_error_construct<E>();
     }
 
     unexpected(const unexpected&) = default;
@@ -598,6 +1088,7 @@ private:
     E val_;
 };
 
+#if !defined(__cpp_impl_three_way_comparison)
 template <class E1, class E2>
 constexpr bool operator==(const unexpected<E1>& lhs, const unexpected<E2>& rhs)
 {
@@ -610,17 +1101,109 @@ constexpr bool operator!=(const unexpected<E1>& lhs, const unexpected<E2>& rhs)
     return !(lhs == rhs);
 }
 
+#endif
+
 template <class E>
 constexpr void swap(unexpected<E>& lhs, unexpected<E>& rhs) noexcept(noexcept(lhs.swap(rhs)))
 {
     lhs.swap(rhs);
 }
 
+#if defined(STD_EXPECTED_TELEMETRY)
+template <class E>
+constexpr unexpected<typename std::decay<E>::type> make_unexpected(
+    E&& e,
+    source_location site = source_location::current())
+{
+    return unexpected<typename std::decay<E>::type>(std::forward<E>(e), site);
+}
+#else
 template <class E>
 constexpr unexpected<typename std::decay<E>::type> make_unexpected(E&& e)
 {
     return unexpected<typename std::decay<E>::type>(std::forward<E>(e));
 }
+#endif
+
+namespace detail
+{
+
+// Shared bodies of the ref-qualified monadic members. Self is the expected forwarded with the
+// member's cv / value category, so *self and self.error() pick the right overloads and the
+// four qualifications of an operation reuse one definition.
+
+template <class Self>
+using error_type_of = typename remove_cvref<Self>::type::error_type;
+
+template <class Self, class F, class R = invoke_result_t<F, decltype(*std::declval<Self>())>>
+constexpr R and_then_expected(Self&& self, F&& f)
+{
+    static_assert(is_expected<R>::value, "F must return expected");
+    return self.has_value()
+               ? std::forward<F>(f)(*std::forward<Self>(self))
+               : R(unexpected<error_type_of<Self>>(std::forward<Self>(self).error()));
+}
+
+template <class Self, class F, class R = invoke_result_t<F>>
+constexpr R and_then_void(Self&& self, F&& f)
+{
+    static_assert(is_expected<R>::value, "F must return expected");
+    return self.has_value()
+               ? std::forward<F>(f)()
+               : R(unexpected<error_type_of<Self>>(std::forward<Self>(self).error()));
+}
+
+template <class Self, class F, class R = typename remove_cvref<Self>::type>
+constexpr R or_else_expected(Self&& self, F&& f)
+{
+    static_assert(
+        std::is_same<R, invoke_result_t<F, decltype(std::declval<Self>().error())>>::value,
+        "F must return the same expected type");
+    return self.has_value() ? R(std::forward<Self>(self))
+                            : std::forward<F>(f)(std::forward<Self>(self).error());
+}
+
+template <class Self,
+          class F,
+          class R = expected<invoke_result_t<F, decltype(*std::declval<Self>())>,
+                             error_type_of<Self>>>
+constexpr R transform_expected(Self&& self, F&& f)
+{
+    return self.has_value()
+               ? R(std::forward<F>(f)(*std::forward<Self>(self)))
+               : R(unexpected<error_type_of<Self>>(std::forward<Self>(self).error()));
+}
+
+template <class Self, class F, class R = expected<invoke_result_t<F>, error_type_of<Self>>>
+constexpr R transform_void(Self&& self, F&& f)
+{
+    return self.has_value()
+               ? (std::forward<F>(f)(), R())
+               : R(unexpected<error_type_of<Self>>(std::forward<Self>(self).error()));
+}
+
+template <class Self,
+          class F,
+          class G = invoke_result_t<F, decltype(std::declval<Self>().error())>,
+          class R = expected<typename remove_cvref<Self>::type::value_type, G>>
+constexpr R transform_error_expected(Self&& self, F&& f)
+{
+    return self.has_value()
+               ? R(in_place, *std::forward<Self>(self))
+               : R(unexpected<G>(std::forward<F>(f)(std::forward<Self>(self).error())));
+}
+
+template <class Self,
+          class F,
+          class G = invoke_result_t<F, decltype(std::declval<Self>().error())>>
+constexpr expected<void, G> transform_error_void(Self&& self, F&& f)
+{
+    return self.has_value() ? expected<void, G>()
+                            : expected<void, G>(unexpected<G>(
+                                  std::forward<F>(f)(std::forward<Self>(self).error())));
+}
+
+}  // namespace detail
 
 template <class T, class E>
 class expected : private detail::expected_base<T, E>
@@ -656,18 +1239,9 @@ public:
     template <class U, class G>
     constexpr expected(
         const expected<U, G>& rhs,
-        typename std::enable_if<std::is_constructible<T, const U&>::value
-                                && std::is_constructible<E, const G&>::value
-                                && !std::is_constructible<T, expected<U, G>&>::value
-                                && !std::is_constructible<T, expected<U, G>>::value
-                                && !std::is_constructible<T, const expected<U, G>&>::value
-                                && !std::is_constructible<T, const expected<U, G>>::value
-                                && !std::is_convertible<expected<U, G>&, T>::value
-                                && !std::is_convertible<expected<U, G>, T>::value
-                                && !std::is_convertible<const expected<U, G>&, T>::value
-                                && !std::is_convertible<const expected<U, G>, T>::value
-                                && (std::is_convertible<const U&, T>::value
-                                    && std::is_convertible<const G&, E>::value)>::type* = nullptr)
+        typename std::enable_if<
+            detail::converts_from_expected<T, E, U, G, const U&, const G&>::value
+            && detail::implicitly_converts<const U&, const G&, T, E>::value>::type* = nullptr)
     {
         if (rhs.has_value())
         {
@@ -683,18 +1257,9 @@ public:
     template <class U, class G>
     constexpr explicit expected(
         const expected<U, G>& rhs,
-        typename std::enable_if<std::is_constructible<T, const U&>::value
-                                && std::is_constructible<E, const G&>::value
-                                && !std::is_constructible<T, expected<U, G>&>::value
-                                && !std::is_constructible<T, expected<U, G>>::value
-                                && !std::is_constructible<T, const expected<U, G>&>::value
-                                && !std::is_constructible<T, const expected<U, G>>::value
-                                && !std::is_convertible<expected<U, G>&, T>::value
-                                && !std::is_convertible<expected<U, G>, T>::value
-                                && !std::is_convertible<const expected<U, G>&, T>::value
-                                && !std::is_convertible<const expected<U, G>, T>::value
-                                && (!std::is_convertible<const U&, T>::value
-                                    || !std::is_convertible<const G&, E>::value)>::type* = nullptr)
+        typename std::enable_if<
+            detail::converts_from_expected<T, E, U, G, const U&, const G&>::value
+            && !detail::implicitly_converts<const U&, const G&, T, E>::value>::type* = nullptr)
     {
         if (rhs.has_value())
         {
@@ -711,17 +1276,8 @@ public:
     constexpr expected(
         expected<U, G>&& rhs,
         typename std::enable_if<
-            std::is_constructible<T, U&&>::value && std::is_constructible<E, G&&>::value
-            && !std::is_constructible<T, expected<U, G>&>::value
-            && !std::is_constructible<T, expected<U, G>>::value
-            && !std::is_constructible<T, const expected<U, G>&>::value
-            && !std::is_constructible<T, const expected<U, G>>::value
-            && !std::is_convertible<expected<U, G>&, T>::value
-            && !std::is_convertible<expected<U, G>, T>::value
-            && !std::is_convertible<const expected<U, G>&, T>::value
-            && !std::is_convertible<const expected<U, G>, T>::value
-            && (std::is_convertible<U&&, T>::value && std::is_convertible<G&&, E>::value)>::type* =
-            nullptr)
+            detail::converts_from_expected<T, E, U, G, U&&, G&&>::value
+            && detail::implicitly_converts<U&&, G&&, T, E>::value>::type* = nullptr)
     {
         if (rhs.has_value())
         {
@@ -737,18 +1293,9 @@ public:
     template <class U, class G>
     constexpr explicit expected(
         expected<U, G>&& rhs,
-        typename std::enable_if<std::is_constructible<T, U&&>::value
-                                && std::is_constructible<E, G&&>::value
-                                && !std::is_constructible<T, expected<U, G>&>::value
-                                && !std::is_constructible<T, expected<U, G>>::value
-                                && !std::is_constructible<T, const expected<U, G>&>::value
-                                && !std::is_constructible<T, const expected<U, G>>::value
-                                && !std::is_convertible<expected<U, G>&, T>::value
-                                && !std::is_convertible<expected<U, G>, T>::value
-                                && !std::is_convertible<const expected<U, G>&, T>::value
-                                && !std::is_convertible<const expected<U, G>, T>::value
-                                && (!std::is_convertible<U&&, T>::value
-                                    || !std::is_convertible<G&&, E>::value)>::type* = nullptr)
+        typename std::enable_if<
+            detail::converts_from_expected<T, E, U, G, U&&, G&&>::value
+            && !detail::implicitly_converts<U&&, G&&, T, E>::value>::type* = nullptr)
     {
         if (rhs.has_value())
         {
@@ -845,6 +1392,7 @@ public:
         std::is_nothrow_constructible<E, Args...>::value)
         : base(detail::in_place_type_t<unexpected_type>{}, std::forward<Args>(args)...)
     {
+        detail::note_error_construct<E>();
     }
 
     template <class U, class... Args>
@@ -856,6 +1404,7 @@ public:
                                                                Args...>::value)
         : base(detail::in_place_type_t<unexpected_type>{}, il, std::forward<Args>(args)...)
     {
+        detail::note_error_construct<E>();
     }
 
     expected& operator=(const expected&) = default;
@@ -921,6 +1470,7 @@ public:
     {
         if (has_value())
         {
+            detail::note_error_transition<E>();
             if (std::is_nothrow_constructible<E, const G&>::value)
             {
                 this->val.~T();
@@ -969,6 +1519,7 @@ public:
     {
         if (has_value())
         {
+            detail::note_error_transition<E>();
             if (std::is_nothrow_constructible<E, G&&>::value)
             {
                 this->val.~T();
@@ -1218,155 +1769,101 @@ public:
     }
 
     template <class F>
-    constexpr auto and_then(F&& f) & -> typename detail::invoke_result<F, T&>::type
+    constexpr auto and_then(F&& f) & -> detail::invoke_result_t<F, T&>
     {
-        static_assert(detail::is_expected<typename detail::invoke_result<F, T&>::type>::value,
-                      "F must return expected");
-        return has_value() ? std::forward<F>(f)(**this)
-                           : typename detail::invoke_result<F, T&>::type(unexpected<E>(error()));
+        return detail::and_then_expected(*this, std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto and_then(F&& f) const& -> typename detail::invoke_result<F, const T&>::type
+    constexpr auto and_then(F&& f) const& -> detail::invoke_result_t<F, const T&>
     {
-        static_assert(detail::is_expected<typename detail::invoke_result<F, const T&>::type>::value,
-                      "F must return expected");
-        return has_value()
-                   ? std::forward<F>(f)(**this)
-                   : typename detail::invoke_result<F, const T&>::type(unexpected<E>(error()));
+        return detail::and_then_expected(*this, std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto and_then(F&& f) && -> typename detail::invoke_result<F, T&&>::type
+    constexpr auto and_then(F&& f) && -> detail::invoke_result_t<F, T&&>
     {
-        static_assert(detail::is_expected<typename detail::invoke_result<F, T&&>::type>::value,
-                      "F must return expected");
-        return has_value() ? std::forward<F>(f)(std::move(**this))
-                           : typename detail::invoke_result<F, T&&>::type(
-                                 unexpected<E>(std::move(error())));
+        return detail::and_then_expected(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto and_then(F&& f) const&& -> typename detail::invoke_result<F, const T&&>::type
+    constexpr auto and_then(F&& f) const&& -> detail::invoke_result_t<F, const T&&>
     {
-        static_assert(
-            detail::is_expected<typename detail::invoke_result<F, const T&&>::type>::value,
-            "F must return expected");
-        return has_value() ? std::forward<F>(f)(std::move(**this))
-                           : typename detail::invoke_result<F, const T&&>::type(
-                                 unexpected<E>(std::move(error())));
+        return detail::and_then_expected(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto or_else(F&& f) & -> expected
     {
-        static_assert(std::is_same<expected, typename detail::invoke_result<F, E&>::type>::value,
-                      "F must return expected<T, E>");
-        return has_value() ? *this : std::forward<F>(f)(error());
+        return detail::or_else_expected(*this, std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto or_else(F&& f) const& -> expected
     {
-        static_assert(
-            std::is_same<expected, typename detail::invoke_result<F, const E&>::type>::value,
-            "F must return expected<T, E>");
-        return has_value() ? *this : std::forward<F>(f)(error());
+        return detail::or_else_expected(*this, std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto or_else(F&& f) && -> expected
     {
-        static_assert(std::is_same<expected, typename detail::invoke_result<F, E&&>::type>::value,
-                      "F must return expected<T, E>");
-        return has_value() ? std::move(*this) : std::forward<F>(f)(std::move(error()));
+        return detail::or_else_expected(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto or_else(F&& f) const&& -> expected
     {
-        static_assert(
-            std::is_same<expected, typename detail::invoke_result<F, const E&&>::type>::value,
-            "F must return expected<T, E>");
-        return has_value() ? std::move(*this) : std::forward<F>(f)(std::move(error()));
+        return detail::or_else_expected(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform(F&& f) & -> expected<typename detail::invoke_result<F, T&>::type, E>
+    constexpr auto transform(F&& f) & -> expected<detail::invoke_result_t<F, T&>, E>
     {
-        return has_value() ? expected<typename detail::invoke_result<F, T&>::type, E>(
-                                 std::forward<F>(f)(**this))
-                           : expected<typename detail::invoke_result<F, T&>::type, E>(
-                                 unexpected<E>(error()));
+        return detail::transform_expected(*this, std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform(
-        F&& f) const& -> expected<typename detail::invoke_result<F, const T&>::type, E>
+    constexpr auto transform(F&& f) const& -> expected<detail::invoke_result_t<F, const T&>, E>
     {
-        return has_value() ? expected<typename detail::invoke_result<F, const T&>::type, E>(
-                                 std::forward<F>(f)(**this))
-                           : expected<typename detail::invoke_result<F, const T&>::type, E>(
-                                 unexpected<E>(error()));
+        return detail::transform_expected(*this, std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform(F&& f) && -> expected<typename detail::invoke_result<F, T&&>::type, E>
+    constexpr auto transform(F&& f) && -> expected<detail::invoke_result_t<F, T&&>, E>
     {
-        return has_value() ? expected<typename detail::invoke_result<F, T&&>::type, E>(
-                                 std::forward<F>(f)(std::move(**this)))
-                           : expected<typename detail::invoke_result<F, T&&>::type, E>(
-                                 unexpected<E>(std::move(error())));
+        return detail::transform_expected(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform(
-        F&& f) const&& -> expected<typename detail::invoke_result<F, const T&&>::type, E>
+    constexpr auto transform(F&& f) const&& -> expected<detail::invoke_result_t<F, const T&&>, E>
     {
-        return has_value() ? expected<typename detail::invoke_result<F, const T&&>::type, E>(
-                                 std::forward<F>(f)(std::move(**this)))
-                           : expected<typename detail::invoke_result<F, const T&&>::type, E>(
-                                 unexpected<E>(std::move(error())));
+        return detail::transform_expected(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform_error(
-        F&& f) & -> expected<void, typename detail::invoke_result<F, E&>::type>
+    constexpr auto transform_error(F&& f) & -> expected<T, detail::invoke_result_t<F, E&>>
     {
-        return has_value() ? expected<void, typename detail::invoke_result<F, E&>::type>()
-                           : expected<void, typename detail::invoke_result<F, E&>::type>(
-                                 unexpected<typename detail::invoke_result<F, E&>::type>(
-                                     std::forward<F>(f)(error())));
+        return detail::transform_error_expected(*this, std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto transform_error(
-        F&& f) const& -> expected<void, typename detail::invoke_result<F, const E&>::type>
+        F&& f) const& -> expected<T, detail::invoke_result_t<F, const E&>>
     {
-        return has_value() ? expected<void, typename detail::invoke_result<F, const E&>::type>()
-                           : expected<void, typename detail::invoke_result<F, const E&>::type>(
-                                 unexpected<typename detail::invoke_result<F, const E&>::type>(
-                                     std::forward<F>(f)(error())));
+        return detail::transform_error_expected(*this, std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform_error(
-        F&& f) && -> expected<void, typename detail::invoke_result<F, E&&>::type>
+    constexpr auto transform_error(F&& f) && -> expected<T, detail::invoke_result_t<F, E&&>>
     {
-        return has_value() ? expected<void, typename detail::invoke_result<F, E&&>::type>()
-                           : expected<void, typename detail::invoke_result<F, E&&>::type>(
-                                 unexpected<typename detail::invoke_result<F, E&&>::type>(
-                                     std::forward<F>(f)(std::move(error()))));
+        return detail::transform_error_expected(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto transform_error(
-        F&& f) const&& -> expected<void, typename detail::invoke_result<F, const E&&>::type>
+        F&& f) const&& -> expected<T, detail::invoke_result_t<F, const E&&>>
     {
-        return has_value() ? expected<void, typename detail::invoke_result<F, const E&&>::type>()
-                           : expected<void, typename detail::invoke_result<F, const E&&>::type>(
-                                 unexpected<typename detail::invoke_result<F, const E&&>::type>(
-                                     std::forward<F>(f)(std::move(error()))));
+        return detail::transform_error_expected(std::move(*this), std::forward<F>(f));
     }
 
     template <class T2, class E2>
@@ -1514,6 +2011,7 @@ public:
         std::is_nothrow_constructible<E, Args...>::value)
         : base(detail::in_place_type_t<unexpected_type>{}, std::forward<Args>(args)...)
     {
+        detail::note_error_construct<E>();
     }
 
     template <class U, class... Args>
@@ -1525,6 +2023,7 @@ public:
                                                                Args...>::value)
         : base(detail::in_place_type_t<unexpected_type>{}, il, std::forward<Args>(args)...)
     {
+        detail::note_error_construct<E>();
     }
 
     expected& operator=(const expected&) = default;
@@ -1540,6 +2039,7 @@ public:
     {
         if (has_value())
         {
+            detail::note_error_transition<E>();
             ::new (static_cast<void*>(detail::addressof(this->err))) E(e.error());
             this->has_val = false;
         }
@@ -1560,6 +2060,7 @@ public:
     {
         if (has_value())
         {
+            detail::note_error_transition<E>();
             ::new (static_cast<void*>(detail::addressof(this->err))) E(std::move(e.error()));
             this->has_val = false;
         }
@@ -1659,149 +2160,101 @@ public:
     }
 
     template <class F>
-    constexpr auto and_then(F&& f) & -> typename detail::invoke_result<F>::type
+    constexpr auto and_then(F&& f) & -> detail::invoke_result_t<F>
     {
-        static_assert(detail::is_expected<typename detail::invoke_result<F>::type>::value,
-                      "F must return expected");
-        return has_value() ? std::forward<F>(f)()
-                           : typename detail::invoke_result<F>::type(unexpected<E>(error()));
+        return detail::and_then_void(*this, std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto and_then(F&& f) const& -> typename detail::invoke_result<F>::type
+    constexpr auto and_then(F&& f) const& -> detail::invoke_result_t<F>
     {
-        static_assert(detail::is_expected<typename detail::invoke_result<F>::type>::value,
-                      "F must return expected");
-        return has_value() ? std::forward<F>(f)()
-                           : typename detail::invoke_result<F>::type(unexpected<E>(error()));
+        return detail::and_then_void(*this, std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto and_then(F&& f) && -> typename detail::invoke_result<F>::type
+    constexpr auto and_then(F&& f) && -> detail::invoke_result_t<F>
     {
-        static_assert(detail::is_expected<typename detail::invoke_result<F>::type>::value,
-                      "F must return expected");
-        return has_value()
-                   ? std::forward<F>(f)()
-                   : typename detail::invoke_result<F>::type(unexpected<E>(std::move(error())));
+        return detail::and_then_void(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto and_then(F&& f) const&& -> typename detail::invoke_result<F>::type
+    constexpr auto and_then(F&& f) const&& -> detail::invoke_result_t<F>
     {
-        static_assert(detail::is_expected<typename detail::invoke_result<F>::type>::value,
-                      "F must return expected");
-        return has_value()
-                   ? std::forward<F>(f)()
-                   : typename detail::invoke_result<F>::type(unexpected<E>(std::move(error())));
+        return detail::and_then_void(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto or_else(F&& f) & -> expected
     {
-        static_assert(std::is_same<expected, typename detail::invoke_result<F, E&>::type>::value,
-                      "F must return expected<void, E>");
-        return has_value() ? *this : std::forward<F>(f)(error());
+        return detail::or_else_expected(*this, std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto or_else(F&& f) const& -> expected
     {
-        static_assert(
-            std::is_same<expected, typename detail::invoke_result<F, const E&>::type>::value,
-            "F must return expected<void, E>");
-        return has_value() ? *this : std::forward<F>(f)(error());
+        return detail::or_else_expected(*this, std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto or_else(F&& f) && -> expected
     {
-        static_assert(std::is_same<expected, typename detail::invoke_result<F, E&&>::type>::value,
-                      "F must return expected<void, E>");
-        return has_value() ? std::move(*this) : std::forward<F>(f)(std::move(error()));
+        return detail::or_else_expected(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto or_else(F&& f) const&& -> expected
     {
-        static_assert(
-            std::is_same<expected, typename detail::invoke_result<F, const E&&>::type>::value,
-            "F must return expected<void, E>");
-        return has_value() ? std::move(*this) : std::forward<F>(f)(std::move(error()));
+        return detail::or_else_expected(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform(F&& f) & -> expected<typename detail::invoke_result<F>::type, E>
+    constexpr auto transform(F&& f) & -> expected<detail::invoke_result_t<F>, E>
     {
-        return has_value()
-                   ? (std::forward<F>(f)(), expected<typename detail::invoke_result<F>::type, E>())
-                   : expected<typename detail::invoke_result<F>::type, E>(unexpected<E>(error()));
+        return detail::transform_void(*this, std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform(F&& f) const& -> expected<typename detail::invoke_result<F>::type, E>
+    constexpr auto transform(F&& f) const& -> expected<detail::invoke_result_t<F>, E>
     {
-        return has_value()
-                   ? (std::forward<F>(f)(), expected<typename detail::invoke_result<F>::type, E>())
-                   : expected<typename detail::invoke_result<F>::type, E>(unexpected<E>(error()));
+        return detail::transform_void(*this, std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform(F&& f) && -> expected<typename detail::invoke_result<F>::type, E>
+    constexpr auto transform(F&& f) && -> expected<detail::invoke_result_t<F>, E>
     {
-        return has_value()
-                   ? (std::forward<F>(f)(), expected<typename detail::invoke_result<F>::type, E>())
-                   : expected<typename detail::invoke_result<F>::type, E>(
-                         unexpected<E>(std::move(error())));
+        return detail::transform_void(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform(F&& f) const&& -> expected<typename detail::invoke_result<F>::type, E>
+    constexpr auto transform(F&& f) const&& -> expected<detail::invoke_result_t<F>, E>
     {
-        return has_value()
-                   ? (std::forward<F>(f)(), expected<typename detail::invoke_result<F>::type, E>())
-                   : expected<typename detail::invoke_result<F>::type, E>(
-                         unexpected<E>(std::move(error())));
+        return detail::transform_void(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform_error(
-        F&& f) & -> expected<void, typename detail::invoke_result<F, E&>::type>
+    constexpr auto transform_error(F&& f) & -> expected<void, detail::invoke_result_t<F, E&>>
     {
-        return has_value() ? expected<void, typename detail::invoke_result<F, E&>::type>()
-                           : expected<void, typename detail::invoke_result<F, E&>::type>(
-                                 unexpected<typename detail::invoke_result<F, E&>::type>(
-                                     std::forward<F>(f)(error())));
+        return detail::transform_error_void(*this, std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto transform_error(
-        F&& f) const& -> expected<void, typename detail::invoke_result<F, const E&>::type>
+        F&& f) const& -> expected<void, detail::invoke_result_t<F, const E&>>
     {
-        return has_value() ? expected<void, typename detail::invoke_result<F, const E&>::type>()
-                           : expected<void, typename detail::invoke_result<F, const E&>::type>(
-                                 unexpected<typename detail::invoke_result<F, const E&>::type>(
-                                     std::forward<F>(f)(error())));
+        return detail::transform_error_void(*this, std::forward<F>(f));
     }
 
     template <class F>
-    constexpr auto transform_error(
-        F&& f) && -> expected<void, typename detail::invoke_result<F, E&&>::type>
+    constexpr auto transform_error(F&& f) && -> expected<void, detail::invoke_result_t<F, E&&>>
     {
-        return has_value() ? expected<void, typename detail::invoke_result<F, E&&>::type>()
-                           : expected<void, typename detail::invoke_result<F, E&&>::type>(
-                                 unexpected<typename detail::invoke_result<F, E&&>::type>(
-                                     std::forward<F>(f)(std::move(error()))));
+        return detail::transform_error_void(std::move(*this), std::forward<F>(f));
     }
 
     template <class F>
     constexpr auto transform_error(
-        F&& f) const&& -> expected<void, typename detail::invoke_result<F, const E&&>::type>
+        F&& f) const&& -> expected<void, detail::invoke_result_t<F, const E&&>>
     {
-        return has_value() ? expected<void, typename detail::invoke_result<F, const E&&>::type>()
-                           : expected<void, typename detail::invoke_result<F, const E&&>::type>(
-                                 unexpected<typename detail::invoke_result<F, const E&&>::type>(
-                                     std::forward<F>(f)(std::move(error()))));
+        return detail::transform_error_void(std::move(*this), std::forward<F>(f));
     }
 
     template <class E2>
@@ -1831,6 +2284,7 @@ public:
     }
 };
 
+#if !defined(__cpp_impl_three_way_comparison)
 template <class T1, class E1, class T2, class E2>
 constexpr bool operator==(const expected<T1, E1>& lhs, const expected<T2, E2>& rhs)
 {
@@ -1891,12 +2345,32 @@ constexpr bool operator!=(const unexpected<E1>& lhs, const expected<T1, E2>& rhs
     return !(lhs == rhs);
 }
 
+#endif
+
 template <class T, class E>
 constexpr void swap(expected<T, E>& lhs, expected<T, E>& rhs) noexcept(noexcept(lhs.swap(rhs)))
 {
     lhs.swap(rhs);
 }
 
+// Common specializations are instantiated once in lib_expected (src/expected.cpp). With
+// STD_EXPECTED_EXTERN_TEMPLATES, including TUs only declare them, so their non-template members
+// are not instantiated, compiled and emitted with debug info again in every object file. Inline
+// calls can still be inlined when optimizing. Keep this list in sync with src/expected.cpp.
+#if defined(STD_EXPECTED_EXTERN_TEMPLATES)
+extern template class unexpected<std::string>;
+extern template class unexpected<std::error_code>;
+
+extern template class expected<void, std::string>;
+extern template class expected<int, std::string>;
+extern template class expected<std::string, std::string>;
+extern template class expected<void, std::error_code>;
+extern template class expected<int, std::error_code>;
+extern template class expected<std::string, std::error_code>;
+#endif
+
 }  // namespace std_
 
+#endif  // STD_EXPECTED_IS_STD
+
 #endif  // End of include guard: LIB_STD_EXPECTED_POLYFILL_CPP11_HPP_ztk3ue
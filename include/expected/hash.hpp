@@ -0,0 +1,240 @@
+#ifndef LIB_STD_EXPECTED_HASH_HPP_n2x6vr
+#define LIB_STD_EXPECTED_HASH_HPP_n2x6vr
+
+#include <expected/expected.hpp>
+#include <expected/wire.hpp>
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <type_traits>
+
+// Hashing of expected results: std::hash<std_::expected<T, E>> and std::hash<std_::unexpected<E>>
+// for unordered containers, the same hash as std_::hash_value(), and hash_batch() for arrays of
+// results.
+//
+// Values and errors are hashed in separate domains, so expected<int, int>(7) and
+// unexpected<int>(7) do not collide by construction; an unexpected<E> hashes like an expected
+// holding that error, matching operator==. Integers and pointers are hashed from their bytes, as
+// are T and E whose object representation is unique (trivially copyable, no padding, no floating
+// point) and that have no std::hash of their own. A payload with an enabled std::hash always goes
+// through it, because its operator== may ignore part of the representation (a generation
+// counter, a cached field); a type like that must provide std::hash. Anything else goes through
+// std::hash<T> and std::hash<E>, and when that is disabled so is the hash of the expected.
+//
+// hash_batch() over a wire::batch_view hashes the contiguous value and error blocks in tight
+// loops 64 items at a time and then scatters the hashes by the success bitmap, giving the same
+// results as hashing item by item. For payloads of up to 8 bytes the block loops vectorize where
+// the target has 64-bit vector multiplies to spare (e.g. GCC with -mavx2); baseline x86-64 runs
+// them scalar.
+
+namespace std_
+{
+
+namespace detail
+{
+
+constexpr std::uint64_t hash_value_domain = 0x9E3779B97F4A7C15ull;
+constexpr std::uint64_t hash_error_domain = 0xC2B2AE3D27D4EB4Full;
+
+// MurmurHash3's 64-bit finalizer.
+constexpr std::uint64_t hash_mix(std::uint64_t h) noexcept
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+inline std::uint64_t hash_bytes(const unsigned char* p, std::size_t n, std::uint64_t seed) noexcept
+{
+    std::uint64_t h = seed ^ hash_mix(n);
+    for (; n >= 8; p += 8, n -= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, p, 8);
+        h = hash_mix(h ^ word);
+    }
+    if (n != 0)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, p, n);
+        h = hash_mix(h ^ word);
+    }
+    return h;
+}
+
+// Integers and pointers, whose std::hash is the library's and whose equality is bitwise, and
+// unique-representation types without a std::hash that could disagree with their bytes.
+template <class T>
+struct hash_as_bytes
+    : std::integral_constant<bool,
+                             std::is_integral<T>::value || std::is_pointer<T>::value
+                                 || (std::is_trivially_copyable<T>::value
+                                     && std::has_unique_object_representations<T>::value
+                                     && !std::is_default_constructible<std::hash<T>>::value)>
+{
+};
+
+// void, byte-hashable, or with an enabled std::hash.
+template <class T>
+concept hashable_payload = std::is_void<T>::value || hash_as_bytes<T>::value
+                           || std::is_default_constructible<std::hash<T>>::value;
+
+template <class T>
+std::uint64_t hash_payload(const T& x, std::uint64_t domain) noexcept
+{
+    if constexpr (hash_as_bytes<T>::value && sizeof(T) <= 8)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, &x, sizeof(T));
+        return hash_mix(word ^ domain);
+    }
+    else if constexpr (hash_as_bytes<T>::value)
+    {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &x, sizeof(T));
+        return hash_bytes(bytes, sizeof(T), domain);
+    }
+    else
+    {
+        return hash_mix(static_cast<std::uint64_t>(std::hash<T>{}(x)) ^ domain);
+    }
+}
+
+// size_t from a 64-bit hash, folding the halves together where size_t is narrower.
+constexpr std::size_t hash_fold(std::uint64_t h) noexcept
+{
+    if constexpr (sizeof(std::size_t) < sizeof(std::uint64_t))
+    {
+        h ^= h >> 32;
+    }
+    return h & SIZE_MAX;
+}
+
+// Hashes n contiguous payloads into out; kept free of branches and calls for the byte path.
+template <class T>
+void hash_block(const T* in, std::size_t n, std::uint64_t domain, std::uint64_t* out) noexcept
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        out[i] = hash_payload(in[i], domain);
+    }
+}
+
+}  // namespace detail
+
+template <class T, class E>
+    requires detail::hashable_payload<T> && detail::hashable_payload<E>
+std::size_t hash_value(const expected<T, E>& r) noexcept
+{
+    if (!r.has_value())
+    {
+        return detail::hash_fold(detail::hash_payload(r.error(), detail::hash_error_domain));
+    }
+    if constexpr (std::is_void<T>::value)
+    {
+        return detail::hash_fold(detail::hash_mix(detail::hash_value_domain));
+    }
+    else
+    {
+        return detail::hash_fold(detail::hash_payload(*r, detail::hash_value_domain));
+    }
+}
+
+template <class E>
+    requires detail::hashable_payload<E>
+std::size_t hash_value(const unexpected<E>& e) noexcept
+{
+    return detail::hash_fold(detail::hash_payload(e.error(), detail::hash_error_domain));
+}
+
+// out[i] = hash_value(results[i]); out must hold at least results.size() hashes.
+template <class T, class E>
+void hash_batch(std::span<const expected<T, E>> results, std::span<std::size_t> out) noexcept
+{
+    assert(out.size() >= results.size());
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        out[i] = hash_value(results[i]);
+    }
+}
+
+// out[i] = hash_value of item i of the batch; out must hold at least batch.size() hashes.
+template <class T, class E>
+void hash_batch(const wire::batch_view<T, E>& batch, std::span<std::size_t> out) noexcept
+{
+    assert(out.size() >= batch.size());
+
+    const std::span<const std::uint64_t> bitmap = batch.bitmap();
+    const T* values = batch.values().data();
+    const E* errors = batch.errors().data();
+    std::uint64_t value_hashes[64] = {};
+    std::uint64_t error_hashes[64] = {};
+
+    for (std::size_t w = 0; w < bitmap.size(); ++w)
+    {
+        const std::size_t n = w + 1 < bitmap.size() ? 64 : batch.size() - w * 64;
+        const std::uint64_t bits = bitmap[w];
+        const std::size_t value_count = static_cast<std::size_t>(std::popcount(bits));
+
+        detail::hash_block(values, value_count, detail::hash_value_domain, value_hashes);
+        detail::hash_block(errors, n - value_count, detail::hash_error_domain, error_hashes);
+        values += value_count;
+        errors += n - value_count;
+
+        // Scatter each block's hashes to the positions of its set (value) or clear (error) bits.
+        std::size_t* dst = out.data() + w * 64;
+        std::uint64_t set = bits;
+        for (std::size_t k = 0; set != 0; ++k, set &= set - 1)
+        {
+            dst[std::countr_zero(set)] = detail::hash_fold(value_hashes[k]);
+        }
+        std::uint64_t clear = ~bits & (n == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << n) - 1);
+        for (std::size_t k = 0; clear != 0; ++k, clear &= clear - 1)
+        {
+            dst[std::countr_zero(clear)] = detail::hash_fold(error_hashes[k]);
+        }
+    }
+}
+
+}  // namespace std_
+
+// std::expected is not ours to specialize std::hash for; hash_value() still works there.
+#if !STD_EXPECTED_IS_STD
+
+namespace std
+{
+
+// Disabled, like std::hash<std::optional<T>>, unless both payloads can be hashed.
+template <class T, class E>
+    requires std_::detail::hashable_payload<T> && std_::detail::hashable_payload<E>
+struct hash<std_::expected<T, E>>
+{
+    std::size_t operator()(const std_::expected<T, E>& r) const noexcept
+    {
+        return std_::hash_value(r);
+    }
+};
+
+template <class E>
+    requires std_::detail::hashable_payload<E>
+struct hash<std_::unexpected<E>>
+{
+    std::size_t operator()(const std_::unexpected<E>& e) const noexcept
+    {
+        return std_::hash_value(e);
+    }
+};
+
+}  // namespace std
+
+#endif
+
+#endif  // End of include guard: LIB_STD_EXPECTED_HASH_HPP_n2x6vr
@@ -0,0 +1,134 @@
+#ifndef LIB_STD_EXPECTED_INTERNED_ERROR_HPP_w8q2mf
+#define LIB_STD_EXPECTED_INTERNED_ERROR_HPP_w8q2mf
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Process-wide interning of error messages. Each distinct text is stored once in a lock-free,
+// insert-only open-addressing table and identified by its slot, so an interned_error is a
+// 4-byte id that compares by integer equality and can be copied across threads freely.
+// Intern hot messages once - e.g. into a namespace-scope constant, which is safe during
+// static initialisation - and construct errors from the saved value. Text is copied into the
+// table unless it is a string literal passed through from_literal(). When the table is full
+// the error gets the reserved overflow id, which compares unequal to everything, itself
+// included, so distinct messages never alias each other or the default-constructed error.
+
+namespace std_
+{
+
+namespace detail
+{
+
+constexpr std::uint32_t interned_overflow_id = 0xFFFF'FFFFu;
+
+// Returns interned_overflow_id when the table is full or the entry cannot be allocated.
+std::uint32_t intern_message(const char* text, std::size_t size, bool borrow) noexcept;
+std::string_view interned_message(std::uint32_t id) noexcept;
+
+// A string literal, checked at compile time: the consteval constructor only accepts constant
+// expressions, so stack buffers and mutable arrays do not convert.
+class literal_text
+{
+public:
+    template <std::size_t N>
+    consteval literal_text(const char (&literal)[N]) noexcept
+        : text_(literal), size_(std::char_traits<char>::length(literal))
+    {
+    }
+
+    constexpr const char* data() const noexcept
+    {
+        return text_;
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+private:
+    const char* text_;
+    std::size_t size_;
+};
+
+}  // namespace detail
+
+class interned_error
+{
+public:
+    using id_type = std::uint32_t;
+
+    static constexpr std::size_t table_capacity = 16 * 1'024;
+    static constexpr id_type overflow_id = detail::interned_overflow_id;
+
+    constexpr interned_error() noexcept : id_(0) {}
+
+    explicit interned_error(const char* text) noexcept : interned_error(std::string_view(text)) {}
+
+    explicit interned_error(std::string_view text) noexcept
+        : id_(detail::intern_message(text.data(), text.size(), false))
+    {
+    }
+
+    explicit interned_error(const std::string& text) noexcept
+        : interned_error(std::string_view(text))
+    {
+    }
+
+    // References the literal in place rather than copying it into the table.
+    static interned_error from_literal(detail::literal_text literal) noexcept
+    {
+        return interned_error(detail::intern_message(literal.data(), literal.size(), true), 0);
+    }
+
+    static constexpr interned_error from_id(id_type id) noexcept
+    {
+        return interned_error(id, 0);
+    }
+
+    constexpr id_type id() const noexcept
+    {
+        return id_;
+    }
+
+    constexpr bool valid() const noexcept
+    {
+        return id_ != 0 && id_ != overflow_id;
+    }
+
+    // The message could not be interned; its text is lost.
+    constexpr bool overflowed() const noexcept
+    {
+        return id_ == overflow_id;
+    }
+
+    // Empty for the default-constructed id; a fixed notice for the overflow id.
+    std::string_view message() const noexcept
+    {
+        return detail::interned_message(id_);
+    }
+
+    friend constexpr bool operator==(interned_error lhs, interned_error rhs) noexcept
+    {
+        return lhs.id_ == rhs.id_ && lhs.id_ != overflow_id;
+    }
+
+    friend constexpr bool operator!=(interned_error lhs, interned_error rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    static std::size_t interned_count() noexcept;
+
+private:
+    constexpr interned_error(id_type id, int) noexcept : id_(id) {}
+
+    id_type id_;
+};
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_INTERNED_ERROR_HPP_w8q2mf
@@ -0,0 +1,239 @@
+#ifndef LIB_STD_EXPECTED_IO_HPP_r2m8xc
+#define LIB_STD_EXPECTED_IO_HPP_r2m8xc
+
+#include <expected/expected.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+// POSIX file I/O reporting failures through expected. io_error is the errno of the failed call
+// plus which call it was; it never allocates. map_file() maps a whole file read-only so that
+// large inputs can be parsed in place instead of being copied into a string first;
+// line_reader streams lines or length-prefixed records out of a reused buffer.
+
+namespace std_
+{
+
+enum class io_op : unsigned char
+{
+    open,
+    stat,
+    map,
+    advise,
+    read,
+    close
+};
+
+class io_error
+{
+public:
+    constexpr io_error(io_op op, int value) noexcept : value_(value), op_(op) {}
+
+    // errno of the calling thread, taken right after the failed call.
+    static io_error from_errno(io_op op) noexcept;
+
+    // What line_reader::next() returns once the input is exhausted: a read with errno 0.
+    static constexpr io_error end_of_file() noexcept
+    {
+        return io_error(io_op::read, 0);
+    }
+
+    constexpr bool is_eof() const noexcept
+    {
+        return value_ == 0;
+    }
+
+    constexpr int value() const noexcept
+    {
+        return value_;
+    }
+
+    constexpr io_op op() const noexcept
+    {
+        return op_;
+    }
+
+    std::error_code code() const noexcept
+    {
+        return std::error_code(value_, std::generic_category());
+    }
+
+    // Name of the failed call, e.g. "open".
+    const char* op_name() const noexcept;
+
+    friend constexpr bool operator==(const io_error& lhs, const io_error& rhs) noexcept
+    {
+        return lhs.value_ == rhs.value_ && lhs.op_ == rhs.op_;
+    }
+
+    friend constexpr bool operator!=(const io_error& lhs, const io_error& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    int value_;
+    io_op op_;
+};
+
+// Access pattern passed to madvise for the mapping.
+enum class access_hint : unsigned char
+{
+    normal,
+    sequential,  // aggressive read-ahead, pages freed soon after use
+    random,      // no read-ahead
+    willneed     // start reading the whole file in now
+};
+
+// Read-only private mapping of a whole file. Move-only; unmaps on destruction. An empty file
+// yields an empty mapping without calling mmap.
+class mapped_file
+{
+public:
+    mapped_file() noexcept = default;
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& rhs) noexcept : data_(rhs.data_), size_(rhs.size_)
+    {
+        rhs.data_ = nullptr;
+        rhs.size_ = 0;
+    }
+
+    mapped_file& operator=(mapped_file&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            unmap();
+            data_ = rhs.data_;
+            size_ = rhs.size_;
+            rhs.data_ = nullptr;
+            rhs.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~mapped_file()
+    {
+        unmap();
+    }
+
+    std::span<const std::byte> bytes() const noexcept
+    {
+        return std::span<const std::byte>(data_, size_);
+    }
+
+    const std::byte* data() const noexcept
+    {
+        return data_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    // Replaces the access hint given to map_file(), e.g. once a sequential scan is done and
+    // lookups become random.
+    expected<void, io_error> advise(access_hint hint) const noexcept;
+
+private:
+    friend expected<mapped_file, io_error> map_file(const char* path, access_hint hint) noexcept;
+
+    mapped_file(const std::byte* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    void unmap() noexcept;
+
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+expected<mapped_file, io_error> map_file(const char* path,
+                                         access_hint hint = access_hint::sequential) noexcept;
+
+inline expected<mapped_file, io_error> map_file(const std::string& path,
+                                                access_hint hint = access_hint::sequential) noexcept
+{
+    return map_file(path.c_str(), hint);
+}
+
+enum class record_format : unsigned char
+{
+    lines,           // '\n'-terminated; the terminator is not part of the record
+    length_prefixed  // native-endian uint32_t byte count, then the payload
+};
+
+struct reader_options
+{
+    std::size_t buffer_size = std::size_t(1) << 20;  // grows for records that do not fit
+    std::size_t max_record = std::size_t(64) << 20;  // longer records fail with EMSGSIZE
+    record_format format = record_format::lines;
+    bool sequential = true;  // posix_fadvise(SEQUENTIAL) on the descriptor, where available
+};
+
+// Buffered reader over a file descriptor. next() returns a view of the next record that points
+// into the reader's buffer and stays valid until the following call. Reads are issued into a
+// 4 KiB aligned position of one buffer that is reused for the whole stream: the unconsumed
+// tail is moved just below an aligned offset before each refill. Lines are found with memchr.
+//
+//     for (auto line = reader.next(); line; line = reader.next()) { ... }
+//
+// The loop ends on an io_error that is either end_of_file() or the failure of a read. A final
+// line without a terminator is still returned; a truncated length-prefixed record fails with
+// EBADMSG. A record longer than max_record fails with EMSGSIZE as soon as that is known - for a
+// length prefix, before any of it is buffered - so corrupt input cannot make the buffer grow
+// without bound. A moved-from reader fails with EBADF.
+class line_reader
+{
+public:
+    static constexpr std::size_t block_size = 4096;
+
+    // Reads from fd without taking ownership of it.
+    explicit line_reader(int fd, const reader_options& options = reader_options());
+
+    static expected<line_reader, io_error> open(const char* path,
+                                                const reader_options& options = reader_options());
+
+    line_reader(line_reader&& rhs) noexcept;
+    line_reader& operator=(line_reader&& rhs) noexcept;
+    line_reader(const line_reader&) = delete;
+    line_reader& operator=(const line_reader&) = delete;
+    ~line_reader();
+
+    expected<std::string_view, io_error> next() noexcept;
+
+    // Bytes read from the descriptor so far.
+    std::uint64_t bytes_read() const noexcept
+    {
+        return bytes_read_;
+    }
+
+private:
+    expected<void, io_error> refill(std::size_t need) noexcept;
+    void release() noexcept;
+
+    int fd_ = -1;
+    bool owns_fd_ = false;
+    bool eof_ = false;
+    record_format format_ = record_format::lines;
+    std::size_t max_record_ = 0;
+    char* buffer_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t begin_ = 0;    // first unconsumed byte
+    std::size_t scanned_ = 0;  // no '\n' in [begin_, scanned_)
+    std::size_t end_ = 0;      // one past the last byte read
+    std::uint64_t bytes_read_ = 0;
+};
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_IO_HPP_r2m8xc
@@ -0,0 +1,339 @@
+#ifndef LIB_STD_EXPECTED_MEMOIZE_HPP_c7t5ge
+#define LIB_STD_EXPECTED_MEMOIZE_HPP_c7t5ge
+
+#include <expected/expected.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+// Thread-safe memoization of a fallible lookup:
+//
+//   // lookup_host: expected<address, resolve_error>(const std::string&)
+//   std_::memoize resolve(lookup_host);
+//   auto address = resolve("db.internal");  // computed once, then served from the cache
+//
+// Results are kept in a fixed number of cache-line-aligned shards, each an unordered_map under
+// its own mutex. Values and errors are cached under separate policies (a short TTL for errors
+// keeps a transient failure from sticking), each with its own least-recently-used list so that
+// a burst of failures cannot evict good values. A caller that misses while another caller is
+// already computing the same key waits for that computation instead of starting its own; if
+// it throws, or caching its result throws, every waiter rethrows the same exception.
+//
+// The function is called concurrently for different keys and must be const-callable with a
+// single key. Key is deduced from its parameter type when it is not overloaded or generic.
+
+namespace std_
+{
+
+struct cache_policy
+{
+    std::chrono::nanoseconds ttl;
+    std::size_t capacity;  // entries over all shards (split evenly); 0 = not cached at all
+};
+
+struct memoize_options
+{
+    cache_policy values{std::chrono::minutes(5), 4'096};
+    cache_policy errors{std::chrono::seconds(1), 1'024};
+    std::size_t shards = 16;  // rounded up to a power of two
+};
+
+struct memoize_stats
+{
+    std::uint64_t hits = 0;        // served from a cached value
+    std::uint64_t error_hits = 0;  // served from a cached error
+    std::uint64_t misses = 0;      // computations started
+    std::uint64_t coalesced = 0;   // served by waiting on another caller's computation
+    std::uint64_t evictions = 0;   // dropped for capacity; expiry is not counted
+};
+
+namespace detail
+{
+
+constexpr std::size_t memo_cache_line = 64;
+
+template <class F>
+struct memo_signature : memo_signature<decltype(&F::operator())>
+{
+};
+
+template <class R, class A>
+struct memo_signature<R (*)(A)>
+{
+    using key = std::decay_t<A>;
+};
+
+template <class R, class A>
+struct memo_signature<R (*)(A) noexcept> : memo_signature<R (*)(A)>
+{
+};
+
+template <class C, class R, class A>
+struct memo_signature<R (C::*)(A) const> : memo_signature<R (*)(A)>
+{
+};
+
+template <class C, class R, class A>
+struct memo_signature<R (C::*)(A) const noexcept> : memo_signature<R (*)(A)>
+{
+};
+
+}  // namespace detail
+
+template <class F,
+          class Key = typename detail::memo_signature<F>::key,
+          class Hash = std::hash<Key>,
+          class Clock = std::chrono::steady_clock>
+class memoize
+{
+public:
+    using key_type = Key;
+    using result_type = std::decay_t<std::invoke_result_t<const F&, const Key&>>;
+
+    static_assert(detail::is_expected<result_type>::value,
+                  "memoize needs a function returning std_::expected");
+
+    explicit memoize(F f, const memoize_options& options = memoize_options())
+        : f_(std::move(f)),
+          ttl_{std::chrono::duration_cast<duration>(options.values.ttl),
+               std::chrono::duration_cast<duration>(options.errors.ttl)}
+    {
+        while ((std::size_t(1) << shard_bits_) < options.shards)
+        {
+            ++shard_bits_;
+        }
+        const std::size_t count = std::size_t(1) << shard_bits_;
+        capacity_[0] = (options.values.capacity + count - 1) / count;
+        capacity_[1] = (options.errors.capacity + count - 1) / count;
+        shards_.reset(new shard[count]);
+        shard_count_ = count;
+    }
+
+    memoize(const memoize&) = delete;
+    memoize& operator=(const memoize&) = delete;
+
+    result_type operator()(const Key& key)
+    {
+        shard& s = shard_for(key);
+        std::unique_lock<std::mutex> lock(s.mutex);
+
+        auto cached = s.entries.find(key);
+        if (cached != s.entries.end())
+        {
+            entry& e = cached->second;
+            if (Clock::now() < e.expires)
+            {
+                std::list<Key>& order = s.recent[e.kind];
+                order.splice(order.begin(), order, e.position);
+                ++(e.kind == 0 ? s.stats.hits : s.stats.error_hits);
+                return e.result;
+            }
+            erase(s, cached);
+        }
+
+        auto running = s.in_flight.find(key);
+        if (running != s.in_flight.end())
+        {
+            std::shared_ptr<pending> p = running->second;
+            ++s.stats.coalesced;
+            p->ready.wait(lock,
+                          [&p]
+                          {
+                              return p->done;
+                          });
+            if (p->failure)
+            {
+                std::rethrow_exception(p->failure);
+            }
+            return *p->result;
+        }
+
+        auto p = std::make_shared<pending>();
+        s.in_flight.emplace(key, p);
+        ++s.stats.misses;
+        lock.unlock();
+
+        std::optional<result_type> result;
+        try
+        {
+            result.emplace(f_(key));
+        }
+        catch (...)
+        {
+            lock.lock();
+            p->failure = std::current_exception();
+            finish(s, key, *p);
+            throw;
+        }
+
+        lock.lock();
+        try
+        {
+            store(s, key, *result);
+            if (p.use_count() > 2)  // waiters hold the other references
+            {
+                p->result = *result;
+            }
+        }
+        catch (...)
+        {
+            // Copying the key or the result failed: the waiters get the exception rather than
+            // being left waiting on an entry that never finishes.
+            p->failure = std::current_exception();
+            finish(s, key, *p);
+            throw;
+        }
+        finish(s, key, *p);
+        return std::move(*result);
+    }
+
+    // Drops a cached result; a computation already running for key is not affected.
+    void invalidate(const Key& key)
+    {
+        shard& s = shard_for(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto cached = s.entries.find(key);
+        if (cached != s.entries.end())
+        {
+            erase(s, cached);
+        }
+    }
+
+    void clear()
+    {
+        for (std::size_t i = 0; i < shard_count_; ++i)
+        {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            shards_[i].entries.clear();
+            shards_[i].recent[0].clear();
+            shards_[i].recent[1].clear();
+        }
+    }
+
+    memoize_stats stats() const
+    {
+        memoize_stats total;
+        for (std::size_t i = 0; i < shard_count_; ++i)
+        {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            const memoize_stats& s = shards_[i].stats;
+            total.hits += s.hits;
+            total.error_hits += s.error_hits;
+            total.misses += s.misses;
+            total.coalesced += s.coalesced;
+            total.evictions += s.evictions;
+        }
+        return total;
+    }
+
+private:
+    using duration = typename Clock::duration;
+    using time_point = typename Clock::time_point;
+
+    struct entry
+    {
+        result_type result;
+        time_point expires;
+        typename std::list<Key>::iterator position;  // in recent[kind]
+        int kind;                                     // 0 = value, 1 = error
+    };
+
+    struct pending
+    {
+        std::condition_variable ready;
+        std::optional<result_type> result;
+        std::exception_ptr failure;
+        bool done = false;
+    };
+
+    struct alignas(detail::memo_cache_line) shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<Key, entry, Hash> entries;
+        std::unordered_map<Key, std::shared_ptr<pending>, Hash> in_flight;
+        std::list<Key> recent[2];  // most recently used first, per kind
+        memoize_stats stats;
+    };
+
+    using entry_iterator = typename std::unordered_map<Key, entry, Hash>::iterator;
+
+    shard& shard_for(const Key& key) const
+    {
+        if (shard_bits_ == 0)
+        {
+            return shards_[0];
+        }
+        // Fibonacci hashing: the top bits, so that the map inside the shard still sees
+        // well-spread low bits even for identity hashes.
+        const std::uint64_t h = static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+        return shards_[h >> (64 - shard_bits_)];
+    }
+
+    static void erase(shard& s, entry_iterator it)
+    {
+        s.recent[it->second.kind].erase(it->second.position);
+        s.entries.erase(it);
+    }
+
+    void store(shard& s, const Key& key, const result_type& result)
+    {
+        const int kind = result.has_value() ? 0 : 1;
+        const std::size_t capacity = capacity_[kind];
+        if (capacity == 0)
+        {
+            return;
+        }
+        auto stale = s.entries.find(key);
+        if (stale != s.entries.end())
+        {
+            erase(s, stale);
+        }
+        std::list<Key>& order = s.recent[kind];
+        if (order.size() >= capacity)
+        {
+            erase(s, s.entries.find(order.back()));
+            ++s.stats.evictions;
+        }
+        order.push_front(key);
+        const time_point expires = Clock::now() + ttl_[kind];
+        try
+        {
+            s.entries.insert_or_assign(key, entry{result, expires, order.begin(), kind});
+        }
+        catch (...)
+        {
+            order.pop_front();  // no list node without its entry
+            throw;
+        }
+    }
+
+    static void finish(shard& s, const Key& key, pending& p)
+    {
+        p.done = true;
+        s.in_flight.erase(key);
+        p.ready.notify_all();
+    }
+
+    F f_;
+    Hash hash_;
+    duration ttl_[2];
+    std::size_t capacity_[2];
+    unsigned shard_bits_ = 0;
+    std::size_t shard_count_ = 0;
+    std::unique_ptr<shard[]> shards_;
+};
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_MEMOIZE_HPP_c7t5ge
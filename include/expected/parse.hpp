@@ -0,0 +1,257 @@
+#ifndef LIB_STD_EXPECTED_PARSE_HPP_k4e9ut
+#define LIB_STD_EXPECTED_PARSE_HPP_k4e9ut
+
+#include <expected/expected.hpp>
+
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+// Non-throwing text to number conversion. parse<T>(text) accepts exactly the whole of text in
+// std::from_chars syntax (no whitespace, no leading '+', decimal integers) and reports failure
+// as a parse_error carrying what went wrong and where. Integers of exactly 8 or 16 digits are
+// converted eight digits at a time in a 64-bit register (SWAR) on little-endian targets;
+// everything else goes through std::from_chars. parse_many() splits a delimited buffer.
+
+namespace std_
+{
+
+enum class parse_errc : unsigned char
+{
+    empty,               // no characters where a value was expected
+    invalid_character,   // position is the first character that is not part of a number
+    out_of_range,        // well-formed, but does not fit T; position is the start
+    too_many_values      // parse_many: more fields than room in the output
+};
+
+struct parse_error
+{
+    parse_errc code;
+    std::uint32_t position;  // offset into the parsed text (the whole buffer for parse_many)
+
+    friend constexpr bool operator==(const parse_error& lhs, const parse_error& rhs) noexcept
+    {
+        return lhs.code == rhs.code && lhs.position == rhs.position;
+    }
+
+    friend constexpr bool operator!=(const parse_error& lhs, const parse_error& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+namespace detail
+{
+
+constexpr std::uint64_t swar_ones = 0x0101010101010101ull;
+
+// True when all eight bytes of chunk are ASCII digits.
+constexpr bool swar_all_digits(std::uint64_t chunk) noexcept
+{
+    return ((chunk & (0xF0 * swar_ones)) | (((chunk + 0x06 * swar_ones) & (0xF0 * swar_ones)) >> 4))
+           == 0x33 * swar_ones;
+}
+
+// Eight ASCII digits, first digit in the lowest byte, to their value.
+constexpr std::uint64_t swar_eight_digits(std::uint64_t chunk) noexcept
+{
+    chunk -= 0x30 * swar_ones;
+    chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFull;
+    chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFull;
+    return (chunk * 10000 + (chunk >> 32)) & 0xFFFFFFFFull;
+}
+
+inline bool swar_digits(const char* p, std::size_t n, std::uint64_t& out) noexcept
+{
+    std::uint64_t hi;
+    std::memcpy(&hi, p, 8);
+    if (!swar_all_digits(hi))
+    {
+        return false;
+    }
+    out = swar_eight_digits(hi);
+    if (n == 16)
+    {
+        std::uint64_t lo;
+        std::memcpy(&lo, p + 8, 8);
+        if (!swar_all_digits(lo))
+        {
+            return false;
+        }
+        out = out * 100000000u + swar_eight_digits(lo);
+    }
+    return true;
+}
+
+template <class T>
+expected<T, parse_error> parse_integer(std::string_view text) noexcept
+{
+    const char* first = text.data();
+    const char* last = first + text.size();
+
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        const bool negative = std::is_signed<T>::value && !text.empty() && text[0] == '-';
+        const std::size_t digits = text.size() - (negative ? 1 : 0);
+        std::uint64_t magnitude;
+        if ((digits == 8 || (digits == 16 && sizeof(T) >= 8))
+            && swar_digits(first + (negative ? 1 : 0), digits, magnitude))
+        {
+            using U = typename std::make_unsigned<T>::type;
+            const std::uint64_t limit =
+                static_cast<U>(std::numeric_limits<T>::max()) + (negative ? 1u : 0u);
+            if (magnitude > limit)
+            {
+                return unexpected<parse_error>(parse_error{parse_errc::out_of_range, 0});
+            }
+            // Two's complement negation in U, so that the minimum of T comes out right.
+            const U bits = negative ? static_cast<U>(U(0) - static_cast<U>(magnitude))
+                                    : static_cast<U>(magnitude);
+            return static_cast<T>(bits);
+        }
+    }
+
+    T value{};
+    const std::from_chars_result r = std::from_chars(first, last, value);
+    if (r.ec == std::errc::result_out_of_range)
+    {
+        return unexpected<parse_error>(parse_error{parse_errc::out_of_range, 0});
+    }
+    if (r.ec != std::errc() || r.ptr != last)
+    {
+        // On failure from_chars leaves ptr at first; find the offending character ourselves.
+        const char* bad = r.ec == std::errc() ? r.ptr : first;
+        if (r.ec != std::errc() && bad != last && *bad == '-' && std::is_signed<T>::value)
+        {
+            ++bad;
+        }
+        return unexpected<parse_error>(
+            parse_error{parse_errc::invalid_character, static_cast<std::uint32_t>(bad - first)});
+    }
+    return value;
+}
+
+template <class T>
+expected<T, parse_error> parse_floating(std::string_view text) noexcept
+{
+    const char* first = text.data();
+    const char* last = first + text.size();
+    T value{};
+    const std::from_chars_result r = std::from_chars(first, last, value);
+    if (r.ec == std::errc::result_out_of_range)
+    {
+        return unexpected<parse_error>(parse_error{parse_errc::out_of_range, 0});
+    }
+    if (r.ec != std::errc() || r.ptr != last)
+    {
+        const char* bad = r.ec == std::errc() ? r.ptr : first;
+        return unexpected<parse_error>(
+            parse_error{parse_errc::invalid_character, static_cast<std::uint32_t>(bad - first)});
+    }
+    return value;
+}
+
+inline expected<bool, parse_error> parse_bool(std::string_view text) noexcept
+{
+    if (text == "true" || text == "1")
+    {
+        return true;
+    }
+    if (text == "false" || text == "0")
+    {
+        return false;
+    }
+    return unexpected<parse_error>(parse_error{parse_errc::invalid_character, 0});
+}
+
+}  // namespace detail
+
+// T is bool ("true", "false", "1", "0"), any other integer type, or a floating-point type.
+template <class T>
+expected<T, parse_error> parse(std::string_view text) noexcept
+{
+    static_assert(std::is_arithmetic<T>::value && !std::is_const<T>::value,
+                  "parse<T> supports bool, integer and floating-point types");
+
+    if (text.empty())
+    {
+        return unexpected<parse_error>(parse_error{parse_errc::empty, 0});
+    }
+    if constexpr (std::is_same<T, bool>::value)
+    {
+        return detail::parse_bool(text);
+    }
+    else if constexpr (std::is_integral<T>::value)
+    {
+        return detail::parse_integer<T>(text);
+    }
+    else
+    {
+        return detail::parse_floating<T>(text);
+    }
+}
+
+// Parses every delimiter-separated field of buffer into out and returns how many were written.
+// One trailing delimiter is allowed, so newline-terminated input needs no trimming. On failure
+// the error position is relative to buffer; out holds the fields before the failing one.
+template <class T>
+expected<std::size_t, parse_error> parse_many(std::string_view buffer,
+                                              char delimiter,
+                                              std::span<T> out) noexcept
+{
+    std::size_t count = 0;
+    std::size_t start = 0;
+    while (start < buffer.size())
+    {
+        const void* hit =
+            std::memchr(buffer.data() + start, delimiter, buffer.size() - start);
+        const std::size_t stop =
+            hit != nullptr ? static_cast<std::size_t>(static_cast<const char*>(hit) - buffer.data())
+                           : buffer.size();
+        if (count == out.size())
+        {
+            return unexpected<parse_error>(
+                parse_error{parse_errc::too_many_values, static_cast<std::uint32_t>(start)});
+        }
+        auto value = parse<T>(buffer.substr(start, stop - start));
+        if (!value)
+        {
+            parse_error e = value.error();
+            e.position += static_cast<std::uint32_t>(start);
+            return unexpected<parse_error>(e);
+        }
+        out[count++] = *value;
+        start = stop + 1;
+    }
+    return count;
+}
+
+template <class T>
+expected<std::vector<T>, parse_error> parse_many(std::string_view buffer, char delimiter)
+{
+    std::size_t fields = 1;
+    for (char c : buffer)
+    {
+        fields += c == delimiter ? 1u : 0u;
+    }
+    std::vector<T> values(fields);
+    auto n = parse_many<T>(buffer, delimiter, std::span<T>(values));
+    if (!n)
+    {
+        return unexpected<parse_error>(n.error());
+    }
+    values.resize(*n);
+    return values;
+}
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_PARSE_HPP_k4e9ut
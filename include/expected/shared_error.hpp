@@ -0,0 +1,197 @@
+#ifndef LIB_STD_EXPECTED_SHARED_ERROR_HPP_c5j8te
+#define LIB_STD_EXPECTED_SHARED_ERROR_HPP_c5j8te
+
+#include <expected/expected.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Immutable, intrusively refcounted error payload. Copying a shared_error - and therefore
+// copying an expected<T, shared_error<E>> in the error state, or the lvalue and_then /
+// transform / or_else paths that copy the error - is one refcount increment regardless of
+// the size of E. The refcount policy picks atomic (default, safe to share across threads) or
+// plain counting for errors that never leave their thread.
+
+namespace std_
+{
+
+struct atomic_refcount
+{
+    using count_type = std::atomic<std::size_t>;
+
+    static void increment(count_type& c) noexcept
+    {
+        c.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static bool decrement(count_type& c) noexcept
+    {
+        return c.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    static std::size_t load(const count_type& c) noexcept
+    {
+        return c.load(std::memory_order_relaxed);
+    }
+};
+
+struct local_refcount
+{
+    using count_type = std::size_t;
+
+    static void increment(count_type& c) noexcept
+    {
+        ++c;
+    }
+
+    static bool decrement(count_type& c) noexcept
+    {
+        return --c == 0;
+    }
+
+    static std::size_t load(const count_type& c) noexcept
+    {
+        return c;
+    }
+};
+
+template <class E, class RefCount = atomic_refcount>
+class shared_error
+{
+    static_assert(!std::is_reference<E>::value, "E must not be a reference");
+    static_assert(!std::is_void<E>::value, "E must not be void");
+
+    struct control
+    {
+        typename RefCount::count_type refs;
+        const E payload;
+
+        template <class... Args>
+        explicit control(Args&&... args) : refs(1), payload(std::forward<Args>(args)...)
+        {
+        }
+    };
+
+public:
+    using element_type = E;
+    using refcount_policy = RefCount;
+
+    template <class... Args,
+              typename std::enable_if<std::is_constructible<E, Args...>::value, int>::type = 0>
+    explicit shared_error(detail::in_place_t, Args&&... args)
+        : ctl_(new control(std::forward<Args>(args)...))
+    {
+    }
+
+    template <class G = E,
+              typename std::enable_if<!std::is_same<typename std::decay<G>::type,
+                                                    shared_error>::value
+                                          && std::is_constructible<E, G&&>::value,
+                                      int>::type = 0>
+    explicit shared_error(G&& g) : ctl_(new control(std::forward<G>(g)))
+    {
+    }
+
+    shared_error(const shared_error& rhs) noexcept : ctl_(rhs.ctl_)
+    {
+        if (ctl_ != nullptr)
+        {
+            RefCount::increment(ctl_->refs);
+        }
+    }
+
+    shared_error(shared_error&& rhs) noexcept : ctl_(rhs.ctl_)
+    {
+        rhs.ctl_ = nullptr;
+    }
+
+    shared_error& operator=(const shared_error& rhs) noexcept
+    {
+        shared_error(rhs).swap(*this);
+        return *this;
+    }
+
+    shared_error& operator=(shared_error&& rhs) noexcept
+    {
+        shared_error(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~shared_error()
+    {
+        if (ctl_ != nullptr && RefCount::decrement(ctl_->refs))
+        {
+            delete ctl_;
+        }
+    }
+
+    const E& get() const noexcept
+    {
+        assert(ctl_ != nullptr && "shared_error accessed after move");
+        return ctl_->payload;
+    }
+
+    const E& operator*() const noexcept
+    {
+        return get();
+    }
+
+    const E* operator->() const noexcept
+    {
+        return detail::addressof(get());
+    }
+
+    std::size_t use_count() const noexcept
+    {
+        return ctl_ != nullptr ? RefCount::load(ctl_->refs) : 0;
+    }
+
+    void swap(shared_error& other) noexcept
+    {
+        std::swap(ctl_, other.ctl_);
+    }
+
+    // Copies of one error compare by identity; independently created errors by payload.
+    template <class E2, class R2>
+    bool operator==(const shared_error<E2, R2>& rhs) const
+    {
+        if (static_cast<const void*>(ctl_) == rhs.identity())
+        {
+            return true;
+        }
+        return ctl_ != nullptr && rhs.identity() != nullptr && get() == rhs.get();
+    }
+
+    template <class E2, class R2>
+    bool operator!=(const shared_error<E2, R2>& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    const void* identity() const noexcept
+    {
+        return ctl_;
+    }
+
+private:
+    control* ctl_;
+};
+
+template <class E, class RefCount>
+void swap(shared_error<E, RefCount>& lhs, shared_error<E, RefCount>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+template <class E, class RefCount = atomic_refcount, class... Args>
+shared_error<E, RefCount> make_shared_error(Args&&... args)
+{
+    return shared_error<E, RefCount>(detail::in_place, std::forward<Args>(args)...);
+}
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_SHARED_ERROR_HPP_c5j8te
@@ -0,0 +1,70 @@
+#ifndef LIB_STD_EXPECTED_SOURCE_LOCATION_HPP_m4c9rx
+#define LIB_STD_EXPECTED_SOURCE_LOCATION_HPP_m4c9rx
+
+#include <cstdint>
+
+#if defined(__has_include)
+    #if __has_include(<source_location>)
+        #include <source_location>
+    #endif
+#endif
+
+namespace std_
+{
+
+#if defined(__cpp_lib_source_location)
+
+using source_location = std::source_location;
+
+#else
+
+class source_location
+{
+public:
+    constexpr source_location() noexcept = default;
+
+    static constexpr source_location current(const char* file = __builtin_FILE(),
+                                             const char* function = __builtin_FUNCTION(),
+                                             std::uint_least32_t line = __builtin_LINE()) noexcept
+    {
+        return source_location(file, function, line);
+    }
+
+    constexpr const char* file_name() const noexcept
+    {
+        return file_;
+    }
+
+    constexpr const char* function_name() const noexcept
+    {
+        return function_;
+    }
+
+    constexpr std::uint_least32_t line() const noexcept
+    {
+        return line_;
+    }
+
+    constexpr std::uint_least32_t column() const noexcept
+    {
+        return 0;
+    }
+
+private:
+    constexpr source_location(const char* file,
+                              const char* function,
+                              std::uint_least32_t line) noexcept
+        : file_(file), function_(function), line_(line)
+    {
+    }
+
+    const char* file_ = "";
+    const char* function_ = "";
+    std::uint_least32_t line_ = 0;
+};
+
+#endif
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_SOURCE_LOCATION_HPP_m4c9rx
@@ -0,0 +1,133 @@
+#ifndef LIB_STD_EXPECTED_STD_BRIDGE_HPP_h5q2vb
+#define LIB_STD_EXPECTED_STD_BRIDGE_HPP_h5q2vb
+
+#include <expected/expected.hpp>
+
+#include <type_traits>
+#include <utility>
+
+#if defined(__has_include)
+#    if __has_include(<version>)
+#        include <version>
+#    endif
+#endif
+
+#if defined(__cpp_lib_expected)
+#    include <expected>
+#endif
+
+// Conversions between std_::expected and C++23 std::expected at API boundaries, available when
+// the standard library has std::expected. to_std() and from_std() take rvalues only and move
+// the value or the error straight into the result, once, with no intermediate temporaries;
+// passing an lvalue is a compile error rather than a silent copy. With STD_EXPECTED_USE_STD
+// (STD_EXPECTED_IS_STD == 1) both sides are the same type and the conversions are plain moves.
+
+#if defined(__cpp_lib_expected)
+
+namespace std_
+{
+
+#if STD_EXPECTED_IS_STD
+
+template <class T, class E>
+constexpr std::expected<T, E> to_std(std::expected<T, E>&& r) noexcept(
+    std::is_nothrow_move_constructible<std::expected<T, E>>::value)
+{
+    return std::move(r);
+}
+
+template <class T, class E>
+constexpr std::expected<T, E> from_std(std::expected<T, E>&& r) noexcept(
+    std::is_nothrow_move_constructible<std::expected<T, E>>::value)
+{
+    return std::move(r);
+}
+
+template <class E>
+constexpr std::unexpected<E> to_std(std::unexpected<E>&& e) noexcept(
+    std::is_nothrow_move_constructible<E>::value)
+{
+    return std::move(e);
+}
+
+template <class E>
+constexpr std::unexpected<E> from_std(std::unexpected<E>&& e) noexcept(
+    std::is_nothrow_move_constructible<E>::value)
+{
+    return std::move(e);
+}
+
+#else
+
+template <class T, class E>
+constexpr std::expected<T, E> to_std(expected<T, E>&& r) noexcept(
+    (std::is_void<T>::value || std::is_nothrow_move_constructible<T>::value)
+    && std::is_nothrow_move_constructible<E>::value)
+{
+    if (!r.has_value())
+    {
+        return std::expected<T, E>(std::unexpect, std::move(r).error());
+    }
+    if constexpr (std::is_void<T>::value)
+    {
+        return std::expected<T, E>();
+    }
+    else
+    {
+        return std::expected<T, E>(std::in_place, *std::move(r));
+    }
+}
+
+template <class T, class E>
+constexpr expected<T, E> from_std(std::expected<T, E>&& r) noexcept(
+    (std::is_void<T>::value || std::is_nothrow_move_constructible<T>::value)
+    && std::is_nothrow_move_constructible<E>::value)
+{
+    if (!r.has_value())
+    {
+        return expected<T, E>(detail::in_place_type_t<unexpected<E>>{}, std::move(r).error());
+    }
+    if constexpr (std::is_void<T>::value)
+    {
+        return expected<T, E>();
+    }
+    else
+    {
+        return expected<T, E>(detail::in_place, *std::move(r));
+    }
+}
+
+template <class E>
+constexpr std::unexpected<E> to_std(unexpected<E>&& e) noexcept(
+    std::is_nothrow_move_constructible<E>::value)
+{
+    return std::unexpected<E>(std::move(e).error());
+}
+
+template <class E>
+constexpr unexpected<E> from_std(std::unexpected<E>&& e) noexcept(
+    std::is_nothrow_move_constructible<E>::value)
+{
+    return unexpected<E>(std::move(e).error());
+}
+
+#endif
+
+// Lvalues have to be moved explicitly: to_std(std::move(r)).
+template <class T, class E>
+void to_std(const expected<T, E>&) = delete;
+
+template <class E>
+void to_std(const unexpected<E>&) = delete;
+
+template <class T, class E>
+void from_std(const std::expected<T, E>&) = delete;
+
+template <class E>
+void from_std(const std::unexpected<E>&) = delete;
+
+}  // namespace std_
+
+#endif  // __cpp_lib_expected
+
+#endif  // End of include guard: LIB_STD_EXPECTED_STD_BRIDGE_HPP_h5q2vb
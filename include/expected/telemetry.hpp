@@ -0,0 +1,162 @@
+#ifndef LIB_STD_EXPECTED_TELEMETRY_HPP_q8w2nf
+#define LIB_STD_EXPECTED_TELEMETRY_HPP_q8w2nf
+
+#include <expected/source_location.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+// Error telemetry. With STD_EXPECTED_TELEMETRY defined, expected.hpp reports every construction
+// of unexpected<E> (with the call site, when the constructor is called with a single error
+// argument) and every transition of an expected from the value to the error state. Events are
+// counted per (typeid(E), event, call site) in a table owned by the recording thread; the hot
+// path is inline: one thread-local load, a one-multiply hash, three compares against the home
+// slot and a plain increment with no atomic read-modify-write; collisions and first sightings
+// of a site go through record_slow(). Trivial copy and move assignments of expected are not
+// hooked, so an error assigned that way is only counted where it was constructed. snapshot()
+// merges the tables of all threads, including exited ones, without locking. Without the macro
+// nothing is recorded and the hooks compile away.
+
+namespace std_
+{
+
+namespace telemetry
+{
+
+enum class event : unsigned char
+{
+    construct,   // unexpected<E> constructed, or expected constructed directly in the error state
+    transition   // an expected holding a value was assigned an error
+};
+
+struct site_count
+{
+    const std::type_info* type;
+    event kind;
+    const char* file;      // "" when the site is unknown
+    const char* function;  // "" when the site is unknown
+    std::uint32_t line;
+    std::uint32_t column;
+    std::uint64_t count;
+};
+
+// Counts of every thread, merged by error type, event and call site, highest count first.
+// Concurrent recording is not blocked; counts are a consistent lower bound per site.
+std::vector<site_count> snapshot();
+
+// Events that found their thread's table full and were counted nowhere else.
+std::uint64_t dropped() noexcept;
+
+// Zeroes all counters. Increments racing with a reset on other threads may survive it.
+void reset() noexcept;
+
+void record_slow(const std::type_info& type, event kind, const source_location& site) noexcept;
+
+}  // namespace telemetry
+
+namespace detail
+{
+
+constexpr std::size_t telemetry_capacity = 256;  // distinct (type, event, site) keys per thread
+
+// Keys are written once by the owning thread and published through `type`; `count` is only
+// ever written by the owner (or telemetry::reset()), so a relaxed load + store is enough.
+// file, function, line and column are only read by snapshot().
+struct telemetry_slot
+{
+    std::atomic<const std::type_info*> type;
+    std::uintptr_t site;
+    std::uint64_t where;
+    const char* file;
+    const char* function;
+    std::uint_least32_t line;
+    std::uint_least32_t column;
+    std::atomic<std::uint64_t> count;
+};
+
+// A call site and event as two words, so that a hit compares three keys. libstdc++ and libc++
+// represent source_location as one pointer to a per-site constant, which identifies the site
+// on its own and folds to an immediate; otherwise the file name is paired with the line,
+// column and event packed into one word (columns are assumed to fit in 31 bits).
+struct telemetry_key
+{
+    std::uintptr_t site;
+    std::uint64_t where;  // the event in bit 0
+};
+
+inline telemetry_key telemetry_site_key(const source_location& site, telemetry::event kind) noexcept
+{
+    if constexpr (sizeof(source_location) == sizeof(std::uintptr_t)
+                  && std::is_trivially_copyable_v<source_location>)
+    {
+        return {std::bit_cast<std::uintptr_t>(site), static_cast<std::uint64_t>(kind)};
+    }
+    else
+    {
+        return {reinterpret_cast<std::uintptr_t>(site.file_name()),
+                (static_cast<std::uint64_t>(site.line()) << 32)
+                    | (static_cast<std::uint64_t>(site.column()) << 1)
+                    | static_cast<std::uint64_t>(kind)};
+    }
+}
+
+inline std::size_t telemetry_hash(const void* type, telemetry_key key) noexcept
+{
+    auto h = reinterpret_cast<std::uintptr_t>(type) ^ (key.site << 7) ^ key.where;
+    h *= static_cast<std::uintptr_t>(0x9e3779b97f4a7c15ull);
+    return h >> (sizeof(h) * 8 - 8);
+}
+
+// Slots of the calling thread's table. Before its first event, and after the thread's lease
+// ends, this points at telemetry_no_slots, whose empty keys never match, so the hit path has
+// no null check. __thread avoids the TLS wrapper call an extern thread_local goes through.
+extern telemetry_slot telemetry_no_slots[telemetry_capacity];
+#if defined(__GNUC__)
+extern __thread telemetry_slot* telemetry_slots;
+#else
+extern thread_local telemetry_slot* telemetry_slots;
+#endif
+
+}  // namespace detail
+
+namespace telemetry
+{
+
+inline void record(const std::type_info& type, event kind, const source_location& site) noexcept
+{
+    const auto key = detail::telemetry_site_key(site, kind);
+    detail::telemetry_slot& s = detail::telemetry_slots[detail::telemetry_hash(&type, key)];
+    if (s.type.load(std::memory_order_relaxed) == &type && s.site == key.site
+        && s.where == key.where)
+    {
+        s.count.store(s.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    record_slow(type, kind, site);
+}
+
+}  // namespace telemetry
+
+namespace detail
+{
+
+template <class E>
+constexpr void note_error(telemetry::event kind,
+                          const source_location& site = source_location()) noexcept
+{
+    if (!__builtin_is_constant_evaluated())
+    {
+        telemetry::record(typeid(E), kind, site);
+    }
+}
+
+}  // namespace detail
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_TELEMETRY_HPP_q8w2nf
@@ -0,0 +1,119 @@
+#ifndef LIB_STD_EXPECTED_TRY_INVOKE_HPP_p9c4lx
+#define LIB_STD_EXPECTED_TRY_INVOKE_HPP_p9c4lx
+
+#include <expected/expected.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// Calls into throwing code and returns the outcome as an expected:
+//
+//   auto n = std_::try_invoke<std::invalid_argument, std::out_of_range>(
+//       [&] { return std::stoi(text); });
+//   // expected<int, std::variant<std::invalid_argument, std::out_of_range, std::exception_ptr>>
+//
+// The listed exception types are caught by reference, in list order (the first one that
+// matches wins, so list derived types before their bases), and copied into their alternative
+// of the error variant; no exception_ptr is created for them. Anything else ends up in the
+// last alternative as std::current_exception(). Every handler is an ordinary catch clause of
+// one nested try block per listed type, so a call that does not throw costs what a plain
+// try/catch costs. When f is noexcept there is no try block at all and so no landing pad.
+// The value type is the decayed result of f; void results give expected<void, ...>.
+
+namespace std_
+{
+
+template <class... Exceptions>
+using caught = std::variant<Exceptions..., std::exception_ptr>;
+
+template <class R, class... Exceptions>
+using try_result = expected<R, caught<Exceptions...>>;
+
+namespace detail
+{
+
+template <class Result, class Call>
+constexpr Result invoke_into(Call& call)
+{
+    if constexpr (std::is_void<typename Result::value_type>::value)
+    {
+        call();
+        return Result();
+    }
+    else
+    {
+        return Result(call());
+    }
+}
+
+// Catches the I-th listed type around the handlers for the ones before it, so that the
+// innermost try block holds the first type and the list is matched in order.
+template <std::size_t I, class Result, class Call>
+Result try_invoke_nested(Call& call)
+{
+    using error_type = typename Result::error_type;
+    using exception_type = std::variant_alternative_t<I, error_type>;
+
+    try
+    {
+        if constexpr (I == 0)
+        {
+            return invoke_into<Result>(call);
+        }
+        else
+        {
+            return try_invoke_nested<I - 1, Result>(call);
+        }
+    }
+    catch (const exception_type& e)
+    {
+        return unexpected<error_type>(error_type(std::in_place_index<I>, e));
+    }
+}
+
+}  // namespace detail
+
+template <class... Exceptions, class F, class... Args>
+auto try_invoke(F&& f, Args&&... args)
+    -> try_result<std::decay_t<std::invoke_result_t<F, Args...>>, Exceptions...>
+{
+    using result_type = try_result<std::decay_t<std::invoke_result_t<F, Args...>>, Exceptions...>;
+    using error_type = typename result_type::error_type;
+
+    auto call = [&]() -> decltype(auto)
+    {
+        return std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+    };
+
+    if constexpr (std::is_nothrow_invocable<F, Args...>::value)
+    {
+        return detail::invoke_into<result_type>(call);
+    }
+    else
+    {
+        try
+        {
+            if constexpr (sizeof...(Exceptions) == 0)
+            {
+                return detail::invoke_into<result_type>(call);
+            }
+            else
+            {
+                return detail::try_invoke_nested<sizeof...(Exceptions) - 1, result_type>(call);
+            }
+        }
+        catch (...)
+        {
+            return unexpected<error_type>(
+                error_type(std::in_place_index<sizeof...(Exceptions)>, std::current_exception()));
+        }
+    }
+}
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_TRY_INVOKE_HPP_p9c4lx
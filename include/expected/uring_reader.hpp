@@ -0,0 +1,68 @@
+#ifndef LIB_STD_EXPECTED_URING_READER_HPP_f6n1zw
+#define LIB_STD_EXPECTED_URING_READER_HPP_f6n1zw
+
+#include <expected/expected.hpp>
+#include <expected/io.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+// Batched positional reads. read_batch() takes a span of requests and fills a caller-provided
+// span of completions, one expected<size_t, io_error> per request, in request order. With
+// liburing (CMake: ENABLE_IO_URING) a batch is queued on an io_uring ring and submitted with
+// one io_uring_enter per queue_depth requests. Without it, or when the kernel refuses to set
+// up a ring, the requests are spread over a fixed pool of threads issuing pread(2). The
+// results are identical either way.
+
+namespace std_
+{
+
+struct read_request
+{
+    int fd;
+    std::uint64_t offset;
+    std::span<std::byte> buffer;
+};
+
+// Bytes read, fewer than buffer.size() only at end of file; or the errno of the read.
+using read_completion = expected<std::size_t, io_error>;
+
+struct uring_options
+{
+    unsigned queue_depth = 64;   // ring entries; requests beyond this are submitted in rounds
+    unsigned pool_threads = 0;   // pread fallback threads, 0 = hardware concurrency (max 8)
+    bool force_fallback = false; // skip io_uring even when it is available
+};
+
+class uring_reader
+{
+public:
+    static expected<uring_reader, io_error> create(const uring_options& options = uring_options());
+
+    uring_reader(uring_reader&& rhs) noexcept;
+    uring_reader& operator=(uring_reader&& rhs) noexcept;
+    ~uring_reader();
+
+    // Blocks until every request has completed. Per-read failures are reported in their
+    // completion. The batch fails as a whole only when completions is shorter than requests
+    // (EINVAL) or the ring itself breaks, in which case the completions are unspecified, no
+    // read is left in flight, and every later batch fails with the same error.
+    expected<void, io_error> read_batch(std::span<const read_request> requests,
+                                        std::span<read_completion> completions) noexcept;
+
+    // True when batches go through io_uring rather than the pread pool.
+    bool uses_io_uring() const noexcept;
+
+private:
+    struct impl;
+
+    explicit uring_reader(std::unique_ptr<impl> p) noexcept;
+
+    std::unique_ptr<impl> impl_;
+};
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_URING_READER_HPP_f6n1zw
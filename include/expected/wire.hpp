@@ -0,0 +1,461 @@
+#ifndef LIB_STD_EXPECTED_WIRE_HPP_v7k3pd
+#define LIB_STD_EXPECTED_WIRE_HPP_v7k3pd
+
+#include <expected/expected.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Binary wire format for expected<T, E> with trivially copyable T and E, in the native byte
+// order of the writer (both ends must agree on the layout of T and E).
+//
+// A single result is a one-byte tag followed by the bytes of the value or the error, unpadded.
+// decode() copies it out, which for trivially copyable types is one memcpy.
+//
+// A batch of results is laid out for zero-copy reading:
+//
+//   batch_header                          40 bytes
+//   success bitmap     uint64_t[words]    bit i set = item i holds a value
+//   rank directory     uint32_t[words]    values in the bitmap words before this one
+//   value block        T[value_count]     aligned to alignof(T)
+//   error block        E[count - value_count], aligned to alignof(E)
+//
+// batch_view reads a batch in place: item i is found with one popcount, and values() /
+// errors() expose the two blocks as contiguous spans. Every offset and rank is validated when
+// the view is created, so a malformed buffer is rejected instead of read out of bounds.
+
+namespace std_
+{
+
+namespace wire
+{
+
+enum class wire_error : unsigned char
+{
+    truncated,      // the buffer ends before the encoded data does
+    bad_tag,        // a single result whose tag is neither value nor error
+    bad_magic,      // not a batch, or written with the other byte order
+    bad_version,
+    type_mismatch,  // sizes or alignments of T and E differ from the writer's
+    corrupt,        // inconsistent offsets, ranks or bitmap
+    misaligned,     // the buffer is not aligned for the header, T or E
+    too_large       // more than 4 GiB of blocks or 2^32 items
+};
+
+enum class tag : unsigned char
+{
+    error = 0,
+    value = 1
+};
+
+template <class T, class E>
+using result_ref = expected<std::reference_wrapper<const T>, std::reference_wrapper<const E>>;
+
+namespace detail
+{
+
+template <class T, class E>
+struct check_wire_types
+{
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+    static_assert(std::is_trivially_copyable<E>::value, "E must be trivially copyable");
+    static constexpr bool value = true;
+};
+
+constexpr std::size_t align_up(std::size_t n, std::size_t alignment) noexcept
+{
+    return (n + alignment - 1) & ~(alignment - 1);
+}
+
+inline bool is_aligned(const void* p, std::size_t alignment) noexcept
+{
+    return (reinterpret_cast<std::uintptr_t>(p) & (alignment - 1)) == 0;
+}
+
+template <class T, class E>
+std::size_t count_values(std::span<const expected<T, E>> items) noexcept
+{
+    std::size_t values = 0;
+    for (const auto& r : items)
+    {
+        values += r.has_value() ? 1u : 0u;
+    }
+    return values;
+}
+
+}  // namespace detail
+
+// --- single results --------------------------------------------------------------------------
+
+template <class T, class E>
+constexpr std::size_t max_encoded_size = 1 + (sizeof(T) > sizeof(E) ? sizeof(T) : sizeof(E));
+
+template <class T, class E>
+std::size_t encoded_size(const expected<T, E>& r) noexcept
+{
+    return 1 + (r.has_value() ? sizeof(T) : sizeof(E));
+}
+
+// Writes r to the front of out and returns the number of bytes written.
+template <class T, class E>
+expected<std::size_t, wire_error> encode(const expected<T, E>& r, std::span<std::byte> out) noexcept
+{
+    static_assert(detail::check_wire_types<T, E>::value, "");
+
+    const std::size_t n = encoded_size(r);
+    if (out.size() < n)
+    {
+        return unexpected<wire_error>(wire_error::truncated);
+    }
+    if (r.has_value())
+    {
+        out[0] = static_cast<std::byte>(tag::value);
+        std::memcpy(out.data() + 1, &*r, sizeof(T));
+    }
+    else
+    {
+        out[0] = static_cast<std::byte>(tag::error);
+        std::memcpy(out.data() + 1, &r.error(), sizeof(E));
+    }
+    return n;
+}
+
+// Reads one result from the front of in; encoded_size() of it is the number of bytes consumed.
+template <class T, class E>
+expected<expected<T, E>, wire_error> decode(std::span<const std::byte> in) noexcept
+{
+    static_assert(detail::check_wire_types<T, E>::value, "");
+    static_assert(std::is_default_constructible<T>::value
+                      && std::is_default_constructible<E>::value,
+                  "decode() copies into a default-constructed T or E");
+
+    if (in.empty())
+    {
+        return unexpected<wire_error>(wire_error::truncated);
+    }
+    const auto t = static_cast<tag>(in[0]);
+    if (t == tag::value)
+    {
+        if (in.size() < 1 + sizeof(T))
+        {
+            return unexpected<wire_error>(wire_error::truncated);
+        }
+        T value;
+        std::memcpy(static_cast<void*>(&value), in.data() + 1, sizeof(T));
+        return expected<T, E>(value);
+    }
+    if (t == tag::error)
+    {
+        if (in.size() < 1 + sizeof(E))
+        {
+            return unexpected<wire_error>(wire_error::truncated);
+        }
+        E error;
+        std::memcpy(static_cast<void*>(&error), in.data() + 1, sizeof(E));
+        return expected<T, E>(unexpected<E>(error));
+    }
+    return unexpected<wire_error>(wire_error::bad_tag);
+}
+
+// --- batches ---------------------------------------------------------------------------------
+
+constexpr std::uint32_t batch_magic = 0x42584553u;  // "SEXB" when read in little endian
+constexpr std::uint16_t batch_version = 1;
+
+struct batch_header
+{
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint8_t value_align;
+    std::uint8_t error_align;
+    std::uint32_t count;
+    std::uint32_t value_count;
+    std::uint32_t value_size;
+    std::uint32_t error_size;
+    std::uint32_t value_offset;
+    std::uint32_t error_offset;
+    std::uint64_t total_size;
+};
+
+static_assert(sizeof(batch_header) == 40, "batch_header layout is part of the format");
+
+struct batch_layout
+{
+    std::size_t words;
+    std::size_t bitmap_offset;
+    std::size_t rank_offset;
+    std::size_t value_offset;
+    std::size_t error_offset;
+    std::size_t total_size;
+};
+
+template <class T, class E>
+constexpr batch_layout layout_for(std::size_t count, std::size_t value_count) noexcept
+{
+    batch_layout l{};
+    l.words = (count + 63) / 64;
+    l.bitmap_offset = sizeof(batch_header);
+    l.rank_offset = l.bitmap_offset + l.words * sizeof(std::uint64_t);
+    l.value_offset = detail::align_up(l.rank_offset + l.words * sizeof(std::uint32_t), alignof(T));
+    l.error_offset = detail::align_up(l.value_offset + value_count * sizeof(T), alignof(E));
+    l.total_size = l.error_offset + (count - value_count) * sizeof(E);
+    return l;
+}
+
+// The header stores the item count and the block offsets in 32 bits.
+constexpr bool fits_batch_format(std::size_t count, const batch_layout& l) noexcept
+{
+    return count <= UINT32_MAX && l.error_offset <= UINT32_MAX;
+}
+
+// Alignment the start of a batch buffer needs for the header, T and E.
+template <class T, class E>
+constexpr std::size_t batch_alignment = alignof(batch_header) > alignof(T)
+                                            ? (alignof(batch_header) > alignof(E)
+                                                   ? alignof(batch_header)
+                                                   : alignof(E))
+                                            : (alignof(T) > alignof(E) ? alignof(T) : alignof(E));
+
+template <class T, class E>
+std::size_t encoded_batch_size(std::span<const expected<T, E>> items) noexcept
+{
+    return layout_for<T, E>(items.size(), detail::count_values(items)).total_size;
+}
+
+// Writes items as a batch to the front of out, which must be aligned to batch_alignment<T, E>.
+// Returns the number of bytes written.
+template <class T, class E>
+expected<std::size_t, wire_error> encode_batch(std::span<const expected<T, E>> items,
+                                               std::span<std::byte> out) noexcept
+{
+    static_assert(detail::check_wire_types<T, E>::value, "");
+
+    const std::size_t values = detail::count_values(items);
+    const batch_layout l = layout_for<T, E>(items.size(), values);
+    if (!fits_batch_format(items.size(), l))
+    {
+        return unexpected<wire_error>(wire_error::too_large);
+    }
+    if (!detail::is_aligned(out.data(), batch_alignment<T, E>))
+    {
+        return unexpected<wire_error>(wire_error::misaligned);
+    }
+    if (out.size() < l.total_size)
+    {
+        return unexpected<wire_error>(wire_error::truncated);
+    }
+
+    std::byte* base = out.data();
+    batch_header h{};
+    h.magic = batch_magic;
+    h.version = batch_version;
+    h.value_align = static_cast<std::uint8_t>(alignof(T));
+    h.error_align = static_cast<std::uint8_t>(alignof(E));
+    h.count = static_cast<std::uint32_t>(items.size());
+    h.value_count = static_cast<std::uint32_t>(values);
+    h.value_size = static_cast<std::uint32_t>(sizeof(T));
+    h.error_size = static_cast<std::uint32_t>(sizeof(E));
+    h.value_offset = static_cast<std::uint32_t>(l.value_offset);
+    h.error_offset = static_cast<std::uint32_t>(l.error_offset);
+    h.total_size = l.total_size;
+    std::memcpy(base, &h, sizeof(h));
+
+    // Padding between the blocks is zeroed so that equal batches encode to equal bytes.
+    std::memset(base + l.rank_offset, 0, l.value_offset - l.rank_offset);
+    std::memset(base + l.value_offset + values * sizeof(T), 0,
+                l.error_offset - l.value_offset - values * sizeof(T));
+
+    auto* bitmap = reinterpret_cast<std::uint64_t*>(base + l.bitmap_offset);
+    auto* rank = reinterpret_cast<std::uint32_t*>(base + l.rank_offset);
+    std::byte* value_out = base + l.value_offset;
+    std::byte* error_out = base + l.error_offset;
+    std::uint32_t seen = 0;
+    for (std::size_t w = 0; w < l.words; ++w)
+    {
+        rank[w] = seen;
+        std::uint64_t bits = 0;
+        const std::size_t end = (w + 1) * 64 < items.size() ? (w + 1) * 64 : items.size();
+        for (std::size_t i = w * 64; i < end; ++i)
+        {
+            const expected<T, E>& r = items[i];
+            if (r.has_value())
+            {
+                bits |= std::uint64_t(1) << (i % 64);
+                std::memcpy(value_out, &*r, sizeof(T));
+                value_out += sizeof(T);
+            }
+            else
+            {
+                std::memcpy(error_out, &r.error(), sizeof(E));
+                error_out += sizeof(E);
+            }
+        }
+        bitmap[w] = bits;
+        seen += static_cast<std::uint32_t>(std::popcount(bits));
+    }
+    return l.total_size;
+}
+
+// Convenience overload; the vector's storage satisfies batch_alignment for types that are not
+// over-aligned. Fails with too_large, before allocating, when the batch does not fit the format.
+template <class T, class E>
+expected<std::vector<std::byte>, wire_error> encode_batch(std::span<const expected<T, E>> items)
+{
+    static_assert(batch_alignment<T, E> <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "over-aligned T / E need a caller-provided buffer");
+
+    const batch_layout l = layout_for<T, E>(items.size(), detail::count_values(items));
+    if (!fits_batch_format(items.size(), l))
+    {
+        return unexpected<wire_error>(wire_error::too_large);
+    }
+    std::vector<std::byte> out(l.total_size);
+    auto written = encode_batch(items, std::span<std::byte>(out));
+    if (!written)
+    {
+        return unexpected<wire_error>(written.error());
+    }
+    return out;
+}
+
+template <class T, class E>
+class batch_view
+{
+    static_assert(detail::check_wire_types<T, E>::value, "");
+
+public:
+    // Validates the header, the layout and the bitmap against the rank directory. Costs one
+    // pass over the bitmap (count / 64 words), not over the items.
+    static expected<batch_view, wire_error> parse(std::span<const std::byte> in) noexcept
+    {
+        if (in.size() < sizeof(batch_header))
+        {
+            return unexpected<wire_error>(wire_error::truncated);
+        }
+        if (!detail::is_aligned(in.data(), batch_alignment<T, E>))
+        {
+            return unexpected<wire_error>(wire_error::misaligned);
+        }
+        batch_header h;
+        std::memcpy(&h, in.data(), sizeof(h));
+        if (h.magic != batch_magic)
+        {
+            return unexpected<wire_error>(wire_error::bad_magic);
+        }
+        if (h.version != batch_version)
+        {
+            return unexpected<wire_error>(wire_error::bad_version);
+        }
+        if (h.value_size != sizeof(T) || h.error_size != sizeof(E) || h.value_align != alignof(T)
+            || h.error_align != alignof(E))
+        {
+            return unexpected<wire_error>(wire_error::type_mismatch);
+        }
+        if (h.value_count > h.count)
+        {
+            return unexpected<wire_error>(wire_error::corrupt);
+        }
+        const batch_layout l = layout_for<T, E>(h.count, h.value_count);
+        if (h.value_offset != l.value_offset || h.error_offset != l.error_offset
+            || h.total_size != l.total_size)
+        {
+            return unexpected<wire_error>(wire_error::corrupt);
+        }
+        if (in.size() < l.total_size)
+        {
+            return unexpected<wire_error>(wire_error::truncated);
+        }
+
+        batch_view v;
+        v.count_ = h.count;
+        v.value_count_ = h.value_count;
+        v.bitmap_ = reinterpret_cast<const std::uint64_t*>(in.data() + l.bitmap_offset);
+        v.rank_ = reinterpret_cast<const std::uint32_t*>(in.data() + l.rank_offset);
+        v.values_ = reinterpret_cast<const T*>(in.data() + l.value_offset);
+        v.errors_ = reinterpret_cast<const E*>(in.data() + l.error_offset);
+
+        std::size_t seen = 0;
+        for (std::size_t w = 0; w < l.words; ++w)
+        {
+            if (v.rank_[w] != seen)
+            {
+                return unexpected<wire_error>(wire_error::corrupt);
+            }
+            seen += static_cast<std::size_t>(std::popcount(v.bitmap_[w]));
+        }
+        const std::size_t tail = h.count % 64;
+        if (seen != h.value_count || (tail != 0 && (v.bitmap_[l.words - 1] >> tail) != 0))
+        {
+            return unexpected<wire_error>(wire_error::corrupt);
+        }
+        return v;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return count_;
+    }
+
+    bool empty() const noexcept
+    {
+        return count_ == 0;
+    }
+
+    bool has_value(std::size_t i) const noexcept
+    {
+        return (bitmap_[i / 64] >> (i % 64)) & 1u;
+    }
+
+    result_ref<T, E> operator[](std::size_t i) const noexcept
+    {
+        const std::uint64_t bits = bitmap_[i / 64];
+        const std::uint64_t below = bits & ((std::uint64_t(1) << (i % 64)) - 1);
+        const std::size_t value_index =
+            rank_[i / 64] + static_cast<std::size_t>(std::popcount(below));
+        if ((bits >> (i % 64)) & 1u)
+        {
+            return std::cref(values_[value_index]);
+        }
+        return unexpected<std::reference_wrapper<const E>>(std::cref(errors_[i - value_index]));
+    }
+
+    // All values in item order, without the errors in between.
+    std::span<const T> values() const noexcept
+    {
+        return std::span<const T>(values_, value_count_);
+    }
+
+    // All errors in item order, without the values in between.
+    std::span<const E> errors() const noexcept
+    {
+        return std::span<const E>(errors_, count_ - value_count_);
+    }
+
+    // The success bitmap: bit i % 64 of word i / 64 is set when item i holds a value.
+    std::span<const std::uint64_t> bitmap() const noexcept
+    {
+        return std::span<const std::uint64_t>(bitmap_, (count_ + 63) / 64);
+    }
+
+private:
+    batch_view() = default;
+
+    std::size_t count_ = 0;
+    std::size_t value_count_ = 0;
+    const std::uint64_t* bitmap_ = nullptr;
+    const std::uint32_t* rank_ = nullptr;
+    const T* values_ = nullptr;
+    const E* errors_ = nullptr;
+};
+
+}  // namespace wire
+
+}  // namespace std_
+
+#endif  // End of include guard: LIB_STD_EXPECTED_WIRE_HPP_v7k3pd
@@ -0,0 +1,133 @@
+#include <expected/error_context.hpp>
+
+#include <cstdlib>
+#include <new>
+
+namespace std_
+{
+
+namespace
+{
+
+constexpr std::size_t default_block_size = 16 * 1'024;
+
+}  // namespace
+
+struct alignas(alignof(std::max_align_t)) context_arena::block
+{
+    block* next;
+    std::size_t capacity;
+    std::size_t base;
+
+    char* data() noexcept
+    {
+        return reinterpret_cast<char*>(this + 1);
+    }
+};
+
+context_arena& context_arena::local() noexcept
+{
+    static thread_local context_arena arena;
+    return arena;
+}
+
+context_arena::~context_arena()
+{
+    while (head_ != nullptr)
+    {
+        block* next = head_->next;
+        std::free(head_);
+        head_ = next;
+    }
+}
+
+void* context_arena::allocate(std::size_t bytes, std::size_t align) noexcept
+{
+    const std::size_t wanted = bytes + align;
+    const auto new_block = [](std::size_t capacity) noexcept -> block*
+    {
+        void* raw = std::malloc(sizeof(block) + capacity);
+        if (raw == nullptr)
+        {
+            return nullptr;
+        }
+        return ::new (raw) block{nullptr, capacity, 0};
+    };
+
+    if (current_ == nullptr)
+    {
+        head_ = new_block(wanted > default_block_size ? wanted : default_block_size);
+        if (head_ == nullptr)
+        {
+            return nullptr;
+        }
+        current_ = head_;
+        offset_ = 0;
+        used_ = 0;
+    }
+
+    std::size_t aligned = (offset_ + align - 1) & ~(align - 1);
+    if (aligned + bytes > current_->capacity)
+    {
+        block* next = current_->next;
+        if (next == nullptr || next->capacity < wanted)
+        {
+            block* fresh = new_block(wanted > default_block_size ? wanted : default_block_size);
+            if (fresh == nullptr)
+            {
+                return nullptr;
+            }
+            fresh->next = next;
+            current_->next = fresh;
+            next = fresh;
+        }
+        next->base = used_;
+        current_ = next;
+        offset_ = 0;
+        aligned = 0;
+    }
+
+    void* p = current_->data() + aligned;
+    offset_ = aligned + bytes;
+    used_ = current_->base + offset_;
+    return p;
+}
+
+void context_arena::rewind(std::size_t mark) noexcept
+{
+    if (current_ == nullptr || mark >= used_)
+    {
+        return;
+    }
+
+    // Blocks past current_ keep stale bases, so only the in-use prefix of the chain is searched.
+    block* b = head_;
+    while (b != current_ && b->next->base <= mark)
+    {
+        b = b->next;
+    }
+    current_ = b;
+    offset_ = mark - b->base;
+    used_ = mark;
+}
+
+namespace detail
+{
+
+const context_frame* push_context_frame(const context_frame* next,
+                                        const char* text,
+                                        std::size_t size) noexcept
+{
+    void* raw = context_arena::local().allocate(sizeof(context_frame) + size, alignof(context_frame));
+    if (raw == nullptr)
+    {
+        return nullptr;
+    }
+    auto* frame = ::new (raw) context_frame{next, size};
+    std::memcpy(frame + 1, text, size);
+    return frame;
+}
+
+}  // namespace detail
+
+}  // namespace std_
@@ -0,0 +1,106 @@
+#include <expected/error_trace.hpp>
+
+#include <atomic>
+#include <new>
+
+#if defined(__has_include)
+    #if __has_include(<execinfo.h>)
+        #include <execinfo.h>
+        #define STD_EXPECTED_HAVE_EXECINFO 1
+    #endif
+#endif
+
+namespace std_
+{
+
+namespace
+{
+
+constexpr int max_backtrace_depth = 32;
+
+}  // namespace
+
+namespace detail
+{
+
+std::atomic<std::uint32_t> backtrace_sample_rate{0};
+
+struct backtrace_record
+{
+    std::atomic<std::uint32_t> refs;
+    int depth;
+    void* frames[max_backtrace_depth];
+};
+
+backtrace_record* capture_backtrace() noexcept
+{
+#if defined(STD_EXPECTED_HAVE_EXECINFO)
+    auto* record = new (std::nothrow) backtrace_record;
+    if (record == nullptr)
+    {
+        return nullptr;
+    }
+    record->refs.store(1, std::memory_order_relaxed);
+    record->depth = ::backtrace(record->frames, max_backtrace_depth);
+    return record;
+#else
+    return nullptr;
+#endif
+}
+
+void retain_backtrace(backtrace_record* record) noexcept
+{
+    if (record != nullptr)
+    {
+        record->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void release_backtrace(backtrace_record* record) noexcept
+{
+    if (record != nullptr && record->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete record;
+    }
+}
+
+error_trace::backtrace_view view_backtrace(const backtrace_record* record) noexcept
+{
+    if (record == nullptr || record->depth <= 0)
+    {
+        return error_trace::backtrace_view{nullptr, 0};
+    }
+    return error_trace::backtrace_view{record->frames, static_cast<std::size_t>(record->depth)};
+}
+
+}  // namespace detail
+
+namespace error_trace
+{
+
+void set_sample_rate(std::uint32_t every_n) noexcept
+{
+    detail::backtrace_sample_rate.store(every_n, std::memory_order_relaxed);
+}
+
+std::uint32_t sample_rate() noexcept
+{
+    return detail::backtrace_sample_rate.load(std::memory_order_relaxed);
+}
+
+void write_backtrace(const backtrace_view& trace, int fd) noexcept
+{
+#if defined(STD_EXPECTED_HAVE_EXECINFO)
+    if (!trace.empty())
+    {
+        ::backtrace_symbols_fd(trace.frames, static_cast<int>(trace.size), fd);
+    }
+#else
+    (void)trace;
+    (void)fd;
+#endif
+}
+
+}  // namespace error_trace
+
+}  // namespace std_
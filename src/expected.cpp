@@ -1 +1,28 @@
-// N / N/A
\ No newline at end of file
+#include <expected/expected.hpp>
+
+#include <string>
+#include <system_error>
+
+// Explicit instantiation definitions matching the extern template declarations at the end of
+// expected.hpp. They are always built, so consumers may opt in to STD_EXPECTED_EXTERN_TEMPLATES
+// on their own without the library being rebuilt. When std_::expected is std::expected there
+// is nothing of ours to instantiate.
+
+#if !STD_EXPECTED_IS_STD
+
+namespace std_
+{
+
+template class unexpected<std::string>;
+template class unexpected<std::error_code>;
+
+template class expected<void, std::string>;
+template class expected<int, std::string>;
+template class expected<std::string, std::string>;
+template class expected<void, std::error_code>;
+template class expected<int, std::error_code>;
+template class expected<std::string, std::error_code>;
+
+}  // namespace std_
+
+#endif
@@ -0,0 +1,47 @@
+// Module interface for the expected library: `import std_expected;` instead of including
+// <expected/expected.hpp>. The header is the single source of truth - it is attached to the
+// module inside an export block, while the standard headers it depends on stay in the global
+// module fragment so their include guards keep them out of the module purview.
+//
+// With GCC, standard headers included after the import in a consumer must already have been
+// included before it (or not at all); put #include lines first. With STD_EXPECTED_TELEMETRY
+// that includes <source_location> and <typeinfo>, which the error constructors use at the
+// call site.
+
+module;
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(STD_EXPECTED_EXTERN_TEMPLATES)
+#    include <string>
+#    include <system_error>
+#endif
+
+#if defined(STD_EXPECTED_TELEMETRY)
+#    include <atomic>
+#    include <cstdint>
+#    include <typeinfo>
+#    include <vector>
+#    if __has_include(<source_location>)
+#        include <source_location>
+#    endif
+#endif
+
+#if defined(STD_EXPECTED_USE_STD) && __has_include(<expected>)
+#    include <expected>
+#    include <memory>
+#    include <version>
+#endif
+
+export module std_expected;
+
+export
+{
+#include <expected/expected.hpp>
+}
@@ -0,0 +1,130 @@
+#include <expected/interned_error.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace std_
+{
+
+namespace
+{
+
+struct entry
+{
+    std::uint64_t hash;
+    std::size_t size;
+    const char* text;
+};
+
+constexpr std::size_t slot_mask = interned_error::table_capacity - 1;
+
+static_assert((interned_error::table_capacity & slot_mask) == 0,
+              "table capacity must be a power of two");
+
+// Zero-initialised before any dynamic initialisation runs, so interning from static
+// constructors in other translation units is safe.
+std::atomic<const entry*> slots[interned_error::table_capacity];
+std::atomic<std::size_t> occupied{0};
+
+std::uint64_t fnv1a(const char* text, std::size_t size) noexcept
+{
+    std::uint64_t h = 14'695'981'039'346'656'037ull;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        h ^= static_cast<unsigned char>(text[i]);
+        h *= 1'099'511'628'211ull;
+    }
+    return h;
+}
+
+bool same_text(const entry* e, std::uint64_t hash, const char* text, std::size_t size) noexcept
+{
+    return e->hash == hash && e->size == size && std::memcmp(e->text, text, size) == 0;
+}
+
+entry* make_entry(std::uint64_t hash, const char* text, std::size_t size, bool borrow) noexcept
+{
+    void* raw = std::malloc(sizeof(entry) + (borrow ? 0 : size + 1));
+    if (raw == nullptr)
+    {
+        return nullptr;
+    }
+    auto* e = ::new (raw) entry{hash, size, text};
+    if (!borrow)
+    {
+        char* copy = reinterpret_cast<char*>(e + 1);
+        std::memcpy(copy, text, size);
+        copy[size] = '\0';
+        e->text = copy;
+    }
+    return e;
+}
+
+}  // namespace
+
+namespace detail
+{
+
+std::uint32_t intern_message(const char* text, std::size_t size, bool borrow) noexcept
+{
+    const std::uint64_t hash = fnv1a(text, size);
+    entry* fresh = nullptr;
+
+    std::size_t idx = static_cast<std::size_t>(hash) & slot_mask;
+    for (std::size_t probe = 0; probe < interned_error::table_capacity; ++probe)
+    {
+        const entry* current = slots[idx].load(std::memory_order_acquire);
+        if (current == nullptr)
+        {
+            if (fresh == nullptr)
+            {
+                fresh = make_entry(hash, text, size, borrow);
+                if (fresh == nullptr)
+                {
+                    return interned_overflow_id;
+                }
+            }
+            if (slots[idx].compare_exchange_strong(current, fresh, std::memory_order_acq_rel,
+                                                   std::memory_order_acquire))
+            {
+                occupied.fetch_add(1, std::memory_order_relaxed);
+                return static_cast<std::uint32_t>(idx + 1);
+            }
+            // Lost the race: `current` now holds the winner, which may be the same text.
+        }
+        if (same_text(current, hash, text, size))
+        {
+            std::free(fresh);
+            return static_cast<std::uint32_t>(idx + 1);
+        }
+        idx = (idx + 1) & slot_mask;
+    }
+
+    std::free(fresh);
+    return interned_overflow_id;
+}
+
+std::string_view interned_message(std::uint32_t id) noexcept
+{
+    if (id == interned_overflow_id)
+    {
+        return "<interned error table full>";
+    }
+    if (id == 0 || id > interned_error::table_capacity)
+    {
+        return std::string_view();
+    }
+    const entry* e = slots[id - 1].load(std::memory_order_acquire);
+    return e != nullptr ? std::string_view(e->text, e->size) : std::string_view();
+}
+
+}  // namespace detail
+
+std::size_t interned_error::interned_count() noexcept
+{
+    return occupied.load(std::memory_order_relaxed);
+}
+
+}  // namespace std_
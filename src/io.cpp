@@ -0,0 +1,414 @@
+#include <expected/io.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define STD_EXPECTED_HAVE_POSIX_IO 1
+#endif
+
+namespace std_
+{
+
+namespace
+{
+
+#if defined(STD_EXPECTED_HAVE_POSIX_IO)
+
+int to_madvise(access_hint hint) noexcept
+{
+    switch (hint)
+    {
+    case access_hint::sequential: return MADV_SEQUENTIAL;
+    case access_hint::random: return MADV_RANDOM;
+    case access_hint::willneed: return MADV_WILLNEED;
+    case access_hint::normal: break;
+    }
+    return MADV_NORMAL;
+}
+
+// Closes fd on every path out of map_file(); the mapping keeps the file alive on its own.
+struct fd_guard
+{
+    int fd;
+
+    ~fd_guard()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+};
+
+#endif
+
+constexpr std::size_t align_up(std::size_t n, std::size_t alignment) noexcept
+{
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+char* allocate_buffer(std::size_t size)
+{
+    return static_cast<char*>(
+        ::operator new(size, std::align_val_t(line_reader::block_size)));
+}
+
+void free_buffer(char* p) noexcept
+{
+    ::operator delete(p, std::align_val_t(line_reader::block_size));
+}
+
+// read(2) retried on EINTR; -1 with errno set on failure.
+long read_some(int fd, char* out, std::size_t n) noexcept
+{
+#if defined(STD_EXPECTED_HAVE_POSIX_IO)
+    for (;;)
+    {
+        const ssize_t got = ::read(fd, out, n);
+        if (got >= 0 || errno != EINTR)
+        {
+            return static_cast<long>(got);
+        }
+    }
+#else
+    (void)fd;
+    (void)out;
+    (void)n;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+}  // namespace
+
+io_error io_error::from_errno(io_op op) noexcept
+{
+    return io_error(op, errno);
+}
+
+const char* io_error::op_name() const noexcept
+{
+    switch (op_)
+    {
+    case io_op::open: return "open";
+    case io_op::stat: return "stat";
+    case io_op::map: return "mmap";
+    case io_op::advise: return "madvise";
+    case io_op::read: return is_eof() ? "end of file" : "read";
+    case io_op::close: return "close";
+    }
+    return "unknown";
+}
+
+#if defined(STD_EXPECTED_HAVE_POSIX_IO)
+
+expected<void, io_error> mapped_file::advise(access_hint hint) const noexcept
+{
+    if (size_ != 0
+        && ::madvise(const_cast<std::byte*>(data_), size_, to_madvise(hint)) != 0)
+    {
+        return unexpected<io_error>(io_error::from_errno(io_op::advise));
+    }
+    return {};
+}
+
+void mapped_file::unmap() noexcept
+{
+    if (data_ != nullptr)
+    {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+expected<mapped_file, io_error> map_file(const char* path, access_hint hint) noexcept
+{
+    fd_guard file{::open(path, O_RDONLY | O_CLOEXEC)};
+    if (file.fd < 0)
+    {
+        return unexpected<io_error>(io_error::from_errno(io_op::open));
+    }
+
+    struct stat st;
+    if (::fstat(file.fd, &st) != 0)
+    {
+        return unexpected<io_error>(io_error::from_errno(io_op::stat));
+    }
+    if (!S_ISREG(st.st_mode))
+    {
+        return unexpected<io_error>(io_error(io_op::map, S_ISDIR(st.st_mode) ? EISDIR : ENODEV));
+    }
+    if (st.st_size == 0)
+    {
+        return mapped_file();
+    }
+
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+    if (p == MAP_FAILED)
+    {
+        return unexpected<io_error>(io_error::from_errno(io_op::map));
+    }
+    mapped_file mapped(static_cast<const std::byte*>(p), size);
+
+    // A failed hint leaves a perfectly usable mapping, so it is not reported.
+    if (hint != access_hint::normal)
+    {
+        (void)mapped.advise(hint);
+    }
+    return mapped;
+}
+
+#else
+
+expected<void, io_error> mapped_file::advise(access_hint) const noexcept
+{
+    return {};
+}
+
+void mapped_file::unmap() noexcept {}
+
+expected<mapped_file, io_error> map_file(const char*, access_hint) noexcept
+{
+    return unexpected<io_error>(io_error(io_op::map, ENOSYS));
+}
+
+#endif
+
+line_reader::line_reader(int fd, const reader_options& options)
+    : fd_(fd),
+      format_(options.format),
+      max_record_(options.max_record),
+      capacity_(align_up(std::max(options.buffer_size, 4 * block_size), block_size))
+{
+    buffer_ = allocate_buffer(capacity_);
+#if defined(STD_EXPECTED_HAVE_POSIX_IO) && defined(POSIX_FADV_SEQUENTIAL)
+    if (options.sequential)
+    {
+        (void)::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+}
+
+expected<line_reader, io_error> line_reader::open(const char* path, const reader_options& options)
+{
+#if defined(STD_EXPECTED_HAVE_POSIX_IO)
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return unexpected<io_error>(io_error::from_errno(io_op::open));
+    }
+    line_reader reader(fd, options);
+    reader.owns_fd_ = true;
+    return reader;
+#else
+    (void)path;
+    (void)options;
+    return unexpected<io_error>(io_error(io_op::open, ENOSYS));
+#endif
+}
+
+line_reader::line_reader(line_reader&& rhs) noexcept
+    : fd_(rhs.fd_),
+      owns_fd_(rhs.owns_fd_),
+      eof_(rhs.eof_),
+      format_(rhs.format_),
+      max_record_(rhs.max_record_),
+      buffer_(rhs.buffer_),
+      capacity_(rhs.capacity_),
+      begin_(rhs.begin_),
+      scanned_(rhs.scanned_),
+      end_(rhs.end_),
+      bytes_read_(rhs.bytes_read_)
+{
+    rhs.fd_ = -1;
+    rhs.owns_fd_ = false;
+    rhs.buffer_ = nullptr;
+    rhs.capacity_ = rhs.begin_ = rhs.scanned_ = rhs.end_ = 0;
+}
+
+line_reader& line_reader::operator=(line_reader&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        release();
+        fd_ = rhs.fd_;
+        owns_fd_ = rhs.owns_fd_;
+        eof_ = rhs.eof_;
+        format_ = rhs.format_;
+        max_record_ = rhs.max_record_;
+        buffer_ = rhs.buffer_;
+        capacity_ = rhs.capacity_;
+        begin_ = rhs.begin_;
+        scanned_ = rhs.scanned_;
+        end_ = rhs.end_;
+        bytes_read_ = rhs.bytes_read_;
+        rhs.fd_ = -1;
+        rhs.owns_fd_ = false;
+        rhs.buffer_ = nullptr;
+        rhs.capacity_ = rhs.begin_ = rhs.scanned_ = rhs.end_ = 0;
+    }
+    return *this;
+}
+
+line_reader::~line_reader()
+{
+    release();
+}
+
+void line_reader::release() noexcept
+{
+    if (buffer_ != nullptr)
+    {
+        free_buffer(buffer_);
+        buffer_ = nullptr;
+    }
+#if defined(STD_EXPECTED_HAVE_POSIX_IO)
+    if (owns_fd_ && fd_ >= 0)
+    {
+        ::close(fd_);
+    }
+#endif
+    fd_ = -1;
+    owns_fd_ = false;
+}
+
+expected<std::string_view, io_error> line_reader::next() noexcept
+{
+    if (buffer_ == nullptr)
+    {
+        return unexpected<io_error>(io_error(io_op::read, EBADF));  // moved from
+    }
+    for (;;)
+    {
+        std::size_t need = 0;
+        if (format_ == record_format::lines)
+        {
+            const void* nl = std::memchr(buffer_ + scanned_, '\n', end_ - scanned_);
+            if (nl != nullptr)
+            {
+                const char* stop = static_cast<const char*>(nl);
+                const auto length = static_cast<std::size_t>(stop - buffer_) - begin_;
+                if (length > max_record_)
+                {
+                    return unexpected<io_error>(io_error(io_op::read, EMSGSIZE));
+                }
+                std::string_view line(buffer_ + begin_, length);
+                begin_ = scanned_ = begin_ + length + 1;
+                return line;
+            }
+            scanned_ = end_;
+            if (end_ - begin_ > max_record_)
+            {
+                return unexpected<io_error>(io_error(io_op::read, EMSGSIZE));
+            }
+        }
+        else
+        {
+            const std::size_t available = end_ - begin_;
+            if (available >= sizeof(std::uint32_t))
+            {
+                std::uint32_t length;
+                std::memcpy(&length, buffer_ + begin_, sizeof(length));
+                if (length > max_record_)
+                {
+                    return unexpected<io_error>(io_error(io_op::read, EMSGSIZE));
+                }
+                if (available - sizeof(length) >= length)
+                {
+                    std::string_view record(buffer_ + begin_ + sizeof(length), length);
+                    begin_ = scanned_ = begin_ + sizeof(length) + length;
+                    return record;
+                }
+                need = sizeof(length) + length;
+            }
+        }
+
+        if (eof_)
+        {
+            if (begin_ == end_)
+            {
+                return unexpected<io_error>(io_error::end_of_file());
+            }
+            const std::size_t rest = end_ - begin_;
+            const std::size_t start = begin_;
+            begin_ = scanned_ = end_;
+            if (format_ == record_format::lines)
+            {
+                return std::string_view(buffer_ + start, rest);
+            }
+            return unexpected<io_error>(io_error(io_op::read, EBADMSG));
+        }
+
+        auto filled = refill(need);
+        if (!filled)
+        {
+            return unexpected<io_error>(filled.error());
+        }
+    }
+}
+
+expected<void, io_error> line_reader::refill(std::size_t need) noexcept
+{
+    const std::size_t tail = end_ - begin_;
+
+    // The tail is placed so that it ends on a block boundary: the read then lands aligned.
+    const std::size_t target = align_up(tail, block_size) - tail;
+    const std::size_t wanted = std::max(need, tail) + block_size;
+    if (target + wanted > capacity_)
+    {
+        std::size_t grown = capacity_;
+        while (target + wanted > grown)
+        {
+            grown *= 2;
+        }
+        char* bigger = static_cast<char*>(
+            ::operator new(grown, std::align_val_t(block_size), std::nothrow));
+        if (bigger == nullptr)
+        {
+            return unexpected<io_error>(io_error(io_op::read, ENOMEM));
+        }
+        std::memcpy(bigger + target, buffer_ + begin_, tail);
+        free_buffer(buffer_);
+        buffer_ = bigger;
+        capacity_ = grown;
+        scanned_ = target + (scanned_ - begin_);
+        begin_ = target;
+        end_ = target + tail;
+    }
+    else if (capacity_ - end_ < capacity_ / 2 || end_ % block_size != 0)
+    {
+        std::memmove(buffer_ + target, buffer_ + begin_, tail);
+        scanned_ = target + (scanned_ - begin_);
+        begin_ = target;
+        end_ = target + tail;
+    }
+
+    std::size_t room = capacity_ - end_;
+    if (room > block_size)
+    {
+        room -= room % block_size;
+    }
+    const long got = read_some(fd_, buffer_ + end_, room);
+    if (got < 0)
+    {
+        return unexpected<io_error>(io_error::from_errno(io_op::read));
+    }
+    if (got == 0)
+    {
+        eof_ = true;
+    }
+    end_ += static_cast<std::size_t>(got);
+    bytes_read_ += static_cast<std::uint64_t>(got);
+    return {};
+}
+
+}  // namespace std_
@@ -0,0 +1,216 @@
+#include <expected/telemetry.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+namespace std_
+{
+
+namespace detail
+{
+
+telemetry_slot telemetry_no_slots[telemetry_capacity] = {};
+
+#if defined(__GNUC__)
+__thread telemetry_slot* telemetry_slots = telemetry_no_slots;
+#else
+thread_local telemetry_slot* telemetry_slots = telemetry_no_slots;
+#endif
+
+}  // namespace detail
+
+namespace telemetry
+{
+
+namespace
+{
+
+using slot = detail::telemetry_slot;
+
+constexpr std::size_t table_capacity = detail::telemetry_capacity;
+static_assert(table_capacity == 256, "telemetry_hash yields an 8-bit index");
+
+constexpr std::size_t max_probe = 16;
+constexpr std::size_t cache_line = 64;
+
+// One table per live thread. Tables are never freed: an exiting thread only gives up its
+// lease, which keeps its counts visible to snapshot() and lets a later thread reuse the table.
+struct alignas(cache_line) thread_table
+{
+    thread_table* next = nullptr;
+    std::atomic<bool> leased{true};
+    std::atomic<std::uint64_t> dropped{0};
+    alignas(cache_line) slot slots[table_capacity] = {};
+};
+
+std::atomic<thread_table*> tables{nullptr};
+
+thread_local thread_table* local_table = nullptr;
+
+thread_table* lease_table() noexcept
+{
+    for (thread_table* t = tables.load(std::memory_order_acquire); t != nullptr; t = t->next)
+    {
+        bool expected = false;
+        if (!t->leased.load(std::memory_order_relaxed)
+            && t->leased.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            return t;
+        }
+    }
+
+    auto* t = new (std::nothrow) thread_table;
+    if (t == nullptr)
+    {
+        return nullptr;
+    }
+    thread_table* head = tables.load(std::memory_order_relaxed);
+    do
+    {
+        t->next = head;
+    } while (!tables.compare_exchange_weak(head, t, std::memory_order_release,
+                                           std::memory_order_relaxed));
+    return t;
+}
+
+struct lease
+{
+    ~lease()
+    {
+        if (local_table != nullptr)
+        {
+            local_table->leased.store(false, std::memory_order_release);
+            local_table = nullptr;
+            detail::telemetry_slots = detail::telemetry_no_slots;
+        }
+    }
+};
+
+thread_table* attach() noexcept
+{
+    static thread_local lease owner;
+    (void)owner;
+    local_table = lease_table();
+    detail::telemetry_slots =
+        local_table != nullptr ? local_table->slots : detail::telemetry_no_slots;
+    return local_table;
+}
+
+bool same_site(const site_count& a, const site_count& b) noexcept
+{
+    return a.kind == b.kind && a.line == b.line && a.column == b.column && *a.type == *b.type
+           && (a.file == b.file || std::strcmp(a.file, b.file) == 0);
+}
+
+}  // namespace
+
+void record_slow(const std::type_info& type, event kind, const source_location& site) noexcept
+{
+    thread_table* t = local_table;
+    if (t == nullptr)
+    {
+        t = attach();
+        if (t == nullptr)
+        {
+            return;
+        }
+    }
+
+    const auto key = detail::telemetry_site_key(site, kind);
+
+    std::size_t index = detail::telemetry_hash(&type, key);
+    for (std::size_t probe = 0; probe < max_probe; ++probe, index = (index + 1) % table_capacity)
+    {
+        slot& s = t->slots[index];
+        const std::type_info* stored = s.type.load(std::memory_order_relaxed);
+        if (stored == &type && s.site == key.site && s.where == key.where)
+        {
+            s.count.store(s.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        if (stored == nullptr)
+        {
+            s.site = key.site;
+            s.where = key.where;
+            s.file = site.file_name();
+            s.function = site.function_name();
+            s.line = site.line();
+            s.column = site.column();
+            s.count.store(1, std::memory_order_relaxed);
+            s.type.store(&type, std::memory_order_release);
+            return;
+        }
+    }
+    t->dropped.store(t->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+std::vector<site_count> snapshot()
+{
+    std::vector<site_count> merged;
+    for (thread_table* t = tables.load(std::memory_order_acquire); t != nullptr; t = t->next)
+    {
+        for (const slot& s : t->slots)
+        {
+            const std::type_info* type = s.type.load(std::memory_order_acquire);
+            if (type == nullptr)
+            {
+                continue;
+            }
+            site_count entry{type, static_cast<event>(s.where & 1), s.file, s.function, s.line,
+                             s.column, s.count.load(std::memory_order_relaxed)};
+            auto it = std::find_if(merged.begin(), merged.end(),
+                                   [&entry](const site_count& m)
+                                   {
+                                       return same_site(m, entry);
+                                   });
+            if (it == merged.end())
+            {
+                merged.push_back(entry);
+            }
+            else
+            {
+                it->count += entry.count;
+            }
+        }
+    }
+    merged.erase(std::remove_if(merged.begin(), merged.end(),
+                                [](const site_count& m)
+                                {
+                                    return m.count == 0;
+                                }),
+                 merged.end());
+    std::sort(merged.begin(), merged.end(),
+              [](const site_count& a, const site_count& b)
+              {
+                  return a.count > b.count;
+              });
+    return merged;
+}
+
+std::uint64_t dropped() noexcept
+{
+    std::uint64_t total = 0;
+    for (thread_table* t = tables.load(std::memory_order_acquire); t != nullptr; t = t->next)
+    {
+        total += t->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void reset() noexcept
+{
+    for (thread_table* t = tables.load(std::memory_order_acquire); t != nullptr; t = t->next)
+    {
+        for (slot& s : t->slots)
+        {
+            s.count.store(0, std::memory_order_relaxed);
+        }
+        t->dropped.store(0, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace telemetry
+
+}  // namespace std_
@@ -0,0 +1,363 @@
+#include <expected/uring_reader.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <unistd.h>
+    #define STD_EXPECTED_HAVE_PREAD 1
+#endif
+
+#if defined(STD_EXPECTED_HAVE_LIBURING)
+    #include <liburing.h>
+#endif
+
+namespace std_
+{
+
+namespace
+{
+
+read_completion read_one(const read_request& r) noexcept
+{
+#if defined(STD_EXPECTED_HAVE_PREAD)
+    for (;;)
+    {
+        const ssize_t got =
+            ::pread(r.fd, r.buffer.data(), r.buffer.size(), static_cast<off_t>(r.offset));
+        if (got >= 0)
+        {
+            return static_cast<std::size_t>(got);
+        }
+        if (errno != EINTR)
+        {
+            return unexpected<io_error>(io_error::from_errno(io_op::read));
+        }
+    }
+#else
+    (void)r;
+    return unexpected<io_error>(io_error(io_op::read, ENOSYS));
+#endif
+}
+
+// Workers pick requests off a shared counter. A batch lives on the caller's stack, so
+// read_batch() only returns once no worker holds a pointer to it any more.
+class pread_pool
+{
+public:
+    explicit pread_pool(unsigned threads)
+    {
+        workers_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i)
+        {
+            workers_.emplace_back(
+                [this]
+                {
+                    run();
+                });
+        }
+    }
+
+    ~pread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& w : workers_)
+        {
+            w.join();
+        }
+    }
+
+    void read_batch(std::span<const read_request> requests, read_completion* out) noexcept
+    {
+        batch b{requests, out};
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            current_ = &b;
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        work(b);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        current_ = nullptr;
+        done_.wait(lock,
+                   [this, &b]
+                   {
+                       return active_ == 0
+                              && b.finished.load(std::memory_order_acquire) == b.requests.size();
+                   });
+    }
+
+private:
+    struct batch
+    {
+        std::span<const read_request> requests;
+        read_completion* out;
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> finished{0};
+    };
+
+    static void work(batch& b) noexcept
+    {
+        for (;;)
+        {
+            const std::size_t i = b.next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= b.requests.size())
+            {
+                return;
+            }
+            b.out[i] = read_one(b.requests[i]);
+            b.finished.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    void run() noexcept
+    {
+        std::uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;)
+        {
+            wake_.wait(lock,
+                       [this, seen]
+                       {
+                           return stop_ || generation_ != seen;
+                       });
+            if (stop_)
+            {
+                return;
+            }
+            seen = generation_;
+            batch* b = current_;
+            if (b == nullptr)
+            {
+                continue;
+            }
+            ++active_;
+            lock.unlock();
+            work(*b);
+            lock.lock();
+            --active_;
+            done_.notify_all();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    batch* current_ = nullptr;
+    std::uint64_t generation_ = 0;
+    unsigned active_ = 0;
+    bool stop_ = false;
+};
+
+}  // namespace
+
+struct uring_reader::impl
+{
+    unsigned queue_depth = 0;
+#if defined(STD_EXPECTED_HAVE_LIBURING)
+    bool ring_ready = false;
+    int ring_error = 0;  // set once the ring is broken; every later batch fails with it
+    io_uring ring{};
+#endif
+    std::unique_ptr<pread_pool> pool;
+
+    ~impl()
+    {
+#if defined(STD_EXPECTED_HAVE_LIBURING)
+        if (ring_ready)
+        {
+            io_uring_queue_exit(&ring);
+        }
+#endif
+    }
+
+#if defined(STD_EXPECTED_HAVE_LIBURING)
+    expected<void, io_error> ring_batch(std::span<const read_request> requests,
+                                        read_completion* out) noexcept
+    {
+        if (ring_error != 0)
+        {
+            return unexpected<io_error>(io_error(io_op::read, ring_error));
+        }
+
+        std::size_t submitted = 0;
+        while (submitted < requests.size())
+        {
+            const std::size_t round =
+                std::min<std::size_t>(queue_depth, requests.size() - submitted);
+            for (std::size_t i = 0; i < round; ++i)
+            {
+                const read_request& r = requests[submitted + i];
+                io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+                io_uring_prep_read(sqe, r.fd, r.buffer.data(),
+                                   static_cast<unsigned>(r.buffer.size()), r.offset);
+                io_uring_sqe_set_data64(sqe, submitted + i);
+            }
+
+            // The kernel only waits once it has taken every entry, so a short count is retried.
+            std::size_t pending = round;
+            int error = 0;
+            while (pending != 0)
+            {
+                const int rc = io_uring_submit_and_wait(&ring, static_cast<unsigned>(pending));
+                if (rc == -EINTR)
+                {
+                    continue;
+                }
+                if (rc <= 0)
+                {
+                    error = rc < 0 ? -rc : EAGAIN;
+                    break;
+                }
+                pending -= static_cast<std::size_t>(rc);
+            }
+
+            // Whatever the kernel took writes into the caller's buffers, so it has to be reaped
+            // before returning, failure or not.
+            const int reap_error = reap(round - pending, requests.size(), out);
+            if (error == 0)
+            {
+                error = reap_error;
+            }
+            if (error != 0)
+            {
+                // Entries left unsubmitted in the ring, or completions that could not be reaped,
+                // would surface in the next batch: the ring is not entered again.
+                ring_error = error;
+                return unexpected<io_error>(io_error(io_op::read, error));
+            }
+            submitted += round;
+        }
+        return {};
+    }
+
+    // Reaps n completions into out; one whose index is not below count is not from this batch
+    // and is dropped. Returns 0 or the errno of a failed wait.
+    int reap(std::size_t n, std::size_t count, read_completion* out) noexcept
+    {
+        while (n != 0)
+        {
+            io_uring_cqe* cqe = nullptr;
+            const int wait = io_uring_wait_cqe(&ring, &cqe);
+            if (wait == -EINTR)
+            {
+                continue;
+            }
+            if (wait < 0)
+            {
+                return -wait;
+            }
+            const std::uint64_t index = io_uring_cqe_get_data64(cqe);
+            if (index < count)
+            {
+                if (cqe->res >= 0)
+                {
+                    out[index] = static_cast<std::size_t>(cqe->res);
+                }
+                else
+                {
+                    out[index] = unexpected<io_error>(io_error(io_op::read, -cqe->res));
+                }
+                --n;
+            }
+            io_uring_cqe_seen(&ring, cqe);
+        }
+        return 0;
+    }
+#endif
+};
+
+expected<uring_reader, io_error> uring_reader::create(const uring_options& options)
+{
+    auto p = std::unique_ptr<impl>(new (std::nothrow) impl);
+    if (p == nullptr)
+    {
+        return unexpected<io_error>(io_error(io_op::open, ENOMEM));
+    }
+    p->queue_depth = std::max(options.queue_depth, 1u);
+
+#if defined(STD_EXPECTED_HAVE_LIBURING)
+    // Containers and hardened kernels often refuse io_uring_setup; the pool covers that.
+    if (!options.force_fallback && io_uring_queue_init(p->queue_depth, &p->ring, 0) == 0)
+    {
+        p->ring_ready = true;
+        return uring_reader(std::move(p));
+    }
+#endif
+
+    unsigned threads = options.pool_threads;
+    if (threads == 0)
+    {
+        threads = std::min(std::max(std::thread::hardware_concurrency(), 1u), 8u);
+    }
+    try
+    {
+        // The calling thread works on each batch too.
+        p->pool.reset(new pread_pool(threads - 1));
+    }
+    catch (const std::system_error& e)
+    {
+        return unexpected<io_error>(io_error(io_op::open, e.code().value()));
+    }
+    catch (const std::bad_alloc&)
+    {
+        return unexpected<io_error>(io_error(io_op::open, ENOMEM));
+    }
+    return uring_reader(std::move(p));
+}
+
+uring_reader::uring_reader(std::unique_ptr<impl> p) noexcept : impl_(std::move(p)) {}
+
+uring_reader::uring_reader(uring_reader&& rhs) noexcept = default;
+
+uring_reader& uring_reader::operator=(uring_reader&& rhs) noexcept = default;
+
+uring_reader::~uring_reader() = default;
+
+expected<void, io_error> uring_reader::read_batch(std::span<const read_request> requests,
+                                                  std::span<read_completion> completions) noexcept
+{
+    if (completions.size() < requests.size() || impl_ == nullptr)
+    {
+        return unexpected<io_error>(io_error(io_op::read, EINVAL));
+    }
+    if (requests.empty())
+    {
+        return {};
+    }
+
+#if defined(STD_EXPECTED_HAVE_LIBURING)
+    if (impl_->ring_ready)
+    {
+        return impl_->ring_batch(requests, completions.data());
+    }
+#endif
+
+    impl_->pool->read_batch(requests, completions.data());
+    return {};
+}
+
+bool uring_reader::uses_io_uring() const noexcept
+{
+#if defined(STD_EXPECTED_HAVE_LIBURING)
+    return impl_ != nullptr && impl_->ring_ready;
+#else
+    return false;
+#endif
+}
+
+}  // namespace std_
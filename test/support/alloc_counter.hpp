@@ -0,0 +1,226 @@
+#ifndef LIB_STD_EXPECTED_TEST_ALLOC_COUNTER_HPP_k7d1xn
+#define LIB_STD_EXPECTED_TEST_ALLOC_COUNTER_HPP_k7d1xn
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Per-thread heap allocation counters for tests and benchmarks. Including this header
+// replaces the global operator new/delete family, so include it from exactly one translation
+// unit per executable. When malloc_shim is preloaded (LD_PRELOAD, see test/CMakeLists.txt)
+// raw malloc/calloc/realloc calls are counted as well, including those made by libraries.
+
+extern "C" __attribute__((weak)) std::uint64_t std_expected_malloc_calls(void);
+
+namespace alloc_counter
+{
+
+struct counts
+{
+    std::uint64_t new_calls;
+    std::uint64_t delete_calls;
+    std::uint64_t new_bytes;
+};
+
+inline counts& local() noexcept
+{
+    static thread_local counts c{0, 0, 0};
+    return c;
+}
+
+inline bool malloc_shim_loaded() noexcept
+{
+    return std_expected_malloc_calls != nullptr;
+}
+
+inline std::uint64_t malloc_calls() noexcept
+{
+    return malloc_shim_loaded() ? std_expected_malloc_calls() : 0;
+}
+
+// Allocations made by this thread since construction.
+class scope
+{
+public:
+    scope() noexcept : start_(local()), malloc_start_(alloc_counter::malloc_calls()) {}
+
+    std::uint64_t new_calls() const noexcept
+    {
+        return local().new_calls - start_.new_calls;
+    }
+
+    std::uint64_t new_bytes() const noexcept
+    {
+        return local().new_bytes - start_.new_bytes;
+    }
+
+    std::uint64_t malloc_calls() const noexcept
+    {
+        return alloc_counter::malloc_calls() - malloc_start_;
+    }
+
+    // operator new goes through malloc, so with the shim loaded its count covers both.
+    std::uint64_t allocations() const noexcept
+    {
+        return malloc_shim_loaded() ? malloc_calls() : new_calls();
+    }
+
+private:
+    counts start_;
+    std::uint64_t malloc_start_;
+};
+
+namespace detail
+{
+
+inline void* counted_alloc(std::size_t size, std::size_t align) noexcept
+{
+    counts& c = local();
+    ++c.new_calls;
+    c.new_bytes += size;
+    if (size == 0)
+    {
+        size = 1;
+    }
+    if (align <= alignof(std::max_align_t))
+    {
+        return std::malloc(size);
+    }
+    return std::aligned_alloc(align, (size + align - 1) & ~(align - 1));
+}
+
+inline void counted_free(void* p) noexcept
+{
+    if (p != nullptr)
+    {
+        ++local().delete_calls;
+        std::free(p);
+    }
+}
+
+inline void* counted_alloc_or_throw(std::size_t size, std::size_t align)
+{
+    void* p = counted_alloc(size, align);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+}  // namespace detail
+
+}  // namespace alloc_counter
+
+// Fails the current test if `...` allocates on this thread.
+#define STD_EXPECTED_ASSERT_NO_ALLOC(...)                                                        \
+    do                                                                                          \
+    {                                                                                           \
+        ::alloc_counter::scope std_expected_alloc_scope_;                                       \
+        __VA_ARGS__;                                                                            \
+        EXPECT_EQ(std_expected_alloc_scope_.allocations(), 0u)                                  \
+            << "expected no heap allocation in: " #__VA_ARGS__;                                 \
+    } while (false)
+
+void* operator new(std::size_t size)
+{
+    return alloc_counter::detail::counted_alloc_or_throw(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size)
+{
+    return alloc_counter::detail::counted_alloc_or_throw(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return alloc_counter::detail::counted_alloc(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return alloc_counter::detail::counted_alloc(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    return alloc_counter::detail::counted_alloc_or_throw(size, static_cast<std::size_t>(align));
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+    return alloc_counter::detail::counted_alloc_or_throw(size, static_cast<std::size_t>(align));
+}
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+    return alloc_counter::detail::counted_alloc(size, static_cast<std::size_t>(align));
+}
+
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+    return alloc_counter::detail::counted_alloc(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* p) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    alloc_counter::detail::counted_free(p);
+}
+
+#endif  // End of include guard: LIB_STD_EXPECTED_TEST_ALLOC_COUNTER_HPP_k7d1xn
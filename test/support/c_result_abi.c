@@ -0,0 +1,60 @@
+#include "c_result_abi.h"
+
+#include <stdalign.h>
+
+abi_point_result abi_make_point(double x, double y, int32_t error)
+{
+    if (error != 0)
+    {
+        return STD_EXPECTED_C_MAKE_ERROR(abi_point_result, error);
+    }
+    abi_point p = {x, y};
+    return STD_EXPECTED_C_MAKE_VALUE(abi_point_result, p);
+}
+
+abi_byte_result abi_make_byte(int value)
+{
+    if (value < 0 || value > 255)
+    {
+        return STD_EXPECTED_C_MAKE_ERROR(abi_byte_result, (uint16_t)value);
+    }
+    return STD_EXPECTED_C_MAKE_VALUE(abi_byte_result, (uint8_t)value);
+}
+
+abi_status abi_check(int64_t error)
+{
+    if (error != 0)
+    {
+        return STD_EXPECTED_C_MAKE_ERROR(abi_status, error);
+    }
+    return STD_EXPECTED_C_MAKE_VOID(abi_status);
+}
+
+double abi_point_sum(abi_point_result r)
+{
+    if (!STD_EXPECTED_C_HAS_VALUE(r))
+    {
+        return -(double)r.u.error;
+    }
+    return r.u.value.x + r.u.value.y;
+}
+
+#define ABI_LAYOUT(type) {sizeof(type), alignof(type), offsetof(type, u)}
+
+abi_layout abi_point_result_layout(void)
+{
+    abi_layout layout = ABI_LAYOUT(abi_point_result);
+    return layout;
+}
+
+abi_layout abi_byte_result_layout(void)
+{
+    abi_layout layout = ABI_LAYOUT(abi_byte_result);
+    return layout;
+}
+
+abi_layout abi_status_layout(void)
+{
+    abi_layout layout = ABI_LAYOUT(abi_status);
+    return layout;
+}
@@ -0,0 +1,52 @@
+/*
+ * C functions over c_result.h types for test_expected_c_result: built as C in c_result_abi.c
+ * and called from C++, so results cross a real C/C++ boundary in both directions.
+ */
+
+#ifndef STD_EXPECTED_TEST_C_RESULT_ABI_H
+#define STD_EXPECTED_TEST_C_RESULT_ABI_H
+
+#include <expected/c_result.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct abi_point
+{
+    double x;
+    double y;
+} abi_point;
+
+STD_EXPECTED_C_RESULT(abi_point_result, abi_point, int32_t);
+STD_EXPECTED_C_RESULT(abi_byte_result, uint8_t, uint16_t);
+STD_EXPECTED_C_RESULT_VOID(abi_status, int64_t);
+
+typedef struct abi_layout
+{
+    size_t size;
+    size_t alignment;
+    size_t union_offset;
+} abi_layout;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/* Results made in C. */
+abi_point_result abi_make_point(double x, double y, int32_t error);
+abi_byte_result abi_make_byte(int value);
+abi_status abi_check(int64_t error);
+
+/* Results made in C++ and read in C: x + y, or -error. */
+double abi_point_sum(abi_point_result r);
+
+/* The C compiler's view of the layouts. */
+abi_layout abi_point_result_layout(void);
+abi_layout abi_byte_result_layout(void);
+abi_layout abi_status_layout(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
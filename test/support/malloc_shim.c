@@ -0,0 +1,73 @@
+/*
+ * LD_PRELOAD shim counting malloc-family calls per thread. Forwards to glibc's __libc_*
+ * entry points, so it needs no dlsym() bootstrap. Queried through the weak
+ * std_expected_malloc_calls() declared in alloc_counter.hpp.
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* p, size_t size);
+extern void* __libc_memalign(size_t align, size_t size);
+extern void __libc_free(void* p);
+
+/* initial-exec: the preloaded library gets static TLS, so the first access cannot recurse
+   into malloc through __tls_get_addr. */
+static __thread uint64_t malloc_calls __attribute__((tls_model("initial-exec")));
+
+uint64_t std_expected_malloc_calls(void)
+{
+    return malloc_calls;
+}
+
+void* malloc(size_t size)
+{
+    ++malloc_calls;
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    ++malloc_calls;
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* p, size_t size)
+{
+    ++malloc_calls;
+    return __libc_realloc(p, size);
+}
+
+void* aligned_alloc(size_t align, size_t size)
+{
+    ++malloc_calls;
+    return __libc_memalign(align, size);
+}
+
+void* memalign(size_t align, size_t size)
+{
+    ++malloc_calls;
+    return __libc_memalign(align, size);
+}
+
+int posix_memalign(void** out, size_t align, size_t size)
+{
+    void* p;
+
+    ++malloc_calls;
+    p = __libc_memalign(align, size);
+    if (p == NULL)
+    {
+        return ENOMEM;
+    }
+    *out = p;
+    return 0;
+}
+
+void free(void* p)
+{
+    __libc_free(p);
+}
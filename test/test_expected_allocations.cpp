@@ -0,0 +1,154 @@
+#include "alloc_counter.hpp"
+
+#include <expected/error_message.hpp>
+#include <expected/expected.hpp>
+#include <expected/interned_error.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+
+
+struct status
+{
+    int code;
+    const char* reason;
+
+    bool operator==(const status& other) const
+    {
+        return code == other.code;
+    }
+};
+
+using result = std_::expected<int, status>;
+
+result parse_digit(char c)
+{
+    if (c < '0' || c > '9')
+    {
+        return std_::unexpected<status>(status{22, "not a digit"});
+    }
+    return c - '0';
+}
+
+result checked_double(int v)
+{
+    if (v > 4)
+    {
+        return std_::unexpected<status>(status{34, "out of range"});
+    }
+    return v * 2;
+}
+
+std::string long_error()
+{
+    return std::string(64, 'e');
+}
+
+TEST(AllocationTest, HarnessCountsAllocations)
+{
+    alloc_counter::scope scope;
+    std::string heap(100, 'x');
+    EXPECT_GE(scope.new_calls(), 1u);
+    EXPECT_GE(scope.allocations(), 1u);
+    EXPECT_GE(scope.new_bytes(), 100u);
+}
+
+TEST(AllocationTest, ShimCountsRawMalloc)
+{
+    if (!alloc_counter::malloc_shim_loaded())
+    {
+        GTEST_SKIP() << "malloc_shim not preloaded";
+    }
+    alloc_counter::scope scope;
+    void* p = std::malloc(32);
+    std::free(p);
+    EXPECT_EQ(scope.malloc_calls(), 1u);
+    EXPECT_EQ(scope.new_calls(), 0u);
+}
+
+TEST(AllocationTest, StatusChainsNeverAllocate)
+{
+    STD_EXPECTED_ASSERT_NO_ALLOC({
+        auto ok = parse_digit('3').and_then(checked_double).transform(
+            [](int v)
+            {
+                return v + 1;
+            });
+        EXPECT_EQ(*ok, 7);
+    });
+
+    STD_EXPECTED_ASSERT_NO_ALLOC({
+        auto bad = parse_digit('x')
+                       .and_then(checked_double)
+                       .transform_error(
+                           [](status s)
+                           {
+                               s.code += 1'000;
+                               return s;
+                           })
+                       .or_else(
+                           [](const status& s)
+                           {
+                               return s.code == 1'022 ? result(0) : result(std_::unexpected<status>(s));
+                           });
+        EXPECT_EQ(*bad, 0);
+    });
+
+    STD_EXPECTED_ASSERT_NO_ALLOC({
+        int v = parse_digit('9').and_then(checked_double).value_or(-1);
+        EXPECT_EQ(v, -1);
+    });
+}
+
+TEST(AllocationTest, RvalueAndThenMovesTheError)
+{
+    const std::string message = long_error();
+    std_::expected<int, std::string> failed{std_::unexpected<std::string>(message)};
+    const auto next = [](int v)
+    {
+        return std_::expected<long, std::string>(v);
+    };
+
+    {
+        alloc_counter::scope scope;
+        auto copied = failed.and_then(next);
+        EXPECT_EQ(scope.new_calls(), 1u) << "lvalue and_then copies the error";
+    }
+
+    STD_EXPECTED_ASSERT_NO_ALLOC({
+        auto moved = std::move(failed).and_then(next);
+        EXPECT_EQ(moved.error(), message);
+    });
+}
+
+TEST(AllocationTest, MoveAssignAcrossStatesDoesNotAllocate)
+{
+    std_::expected<int, std::string> target(1);
+    std_::expected<int, std::string> source{std_::unexpected<std::string>(long_error())};
+
+    STD_EXPECTED_ASSERT_NO_ALLOC(target = std::move(source));
+    EXPECT_FALSE(target.has_value());
+}
+
+TEST(AllocationTest, FixedSizeErrorTypesDoNotAllocate)
+{
+    const std::string detail(40, 'd');
+    const std_::interned_error timeout("operation timed out");
+
+    STD_EXPECTED_ASSERT_NO_ALLOC({
+        std_::expected<int, std_::error_message> literal{
+            std_::unexpected<std_::error_message>("connection refused")};
+        std_::expected<int, std_::error_message> inline_text{
+            std_::unexpected<std_::error_message>(std_::error_message(detail))};
+        auto copy = inline_text;
+        EXPECT_EQ(copy, inline_text);
+        EXPECT_FALSE(literal.has_value());
+    });
+
+    STD_EXPECTED_ASSERT_NO_ALLOC({
+        std_::expected<int, std_::interned_error> e{std_::unexpected<std_::interned_error>(timeout)};
+        auto copy = e;
+        EXPECT_EQ(copy.error(), timeout);
+    });
+}
@@ -0,0 +1,88 @@
+#include <c_result_abi.h>
+#include <expected/c_result.hpp>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace
+{
+
+template <class Result>
+void expect_layout(const abi_layout& c_side)
+{
+    EXPECT_EQ(sizeof(Result), c_side.size);
+    EXPECT_EQ(alignof(Result), c_side.alignment);
+    EXPECT_EQ(offsetof(Result, u), c_side.union_offset);
+}
+
+}  // namespace
+
+TEST(CResultTest, MacrosNameTheCxxLayout)
+{
+    static_assert(std::is_same<abi_point_result, std_::c_result<abi_point, std::int32_t>>::value,
+                  "");
+    static_assert(std::is_same<abi_status, std_::c_result<void, std::int64_t>>::value, "");
+    SUCCEED();
+}
+
+TEST(CResultTest, LayoutMatchesTheCCompiler)
+{
+    expect_layout<abi_point_result>(abi_point_result_layout());
+    expect_layout<abi_byte_result>(abi_byte_result_layout());
+    expect_layout<abi_status>(abi_status_layout());
+
+    EXPECT_EQ(offsetof(abi_point_result, u), 8u);
+    EXPECT_EQ(offsetof(abi_byte_result, u), 4u);
+    EXPECT_EQ(sizeof(abi_byte_result), 8u);
+}
+
+TEST(CResultTest, ResultsMadeInC)
+{
+    std_::expected<abi_point, std::int32_t> p = std_::from_c(abi_make_point(1.5, 2.0, 0));
+    ASSERT_TRUE(p.has_value());
+    EXPECT_EQ(p->x, 1.5);
+    EXPECT_EQ(p->y, 2.0);
+
+    auto failed = std_::from_c(abi_make_point(0, 0, 42));
+    ASSERT_FALSE(failed.has_value());
+    EXPECT_EQ(failed.error(), 42);
+
+    EXPECT_EQ(*std_::from_c(abi_make_byte(200)), 200u);
+    EXPECT_EQ(std_::from_c(abi_make_byte(300)).error(), 300u);
+
+    EXPECT_TRUE(std_::from_c(abi_check(0)).has_value());
+    EXPECT_EQ(std_::from_c(abi_check(-7)).error(), -7);
+}
+
+TEST(CResultTest, ResultsReadInC)
+{
+    std_::expected<abi_point, std::int32_t> p = abi_point{3.0, 4.0};
+    EXPECT_EQ(abi_point_sum(std_::as_c(p)), 7.0);
+
+    std_::expected<abi_point, std::int32_t> bad = std_::unexpected<std::int32_t>(5);
+    EXPECT_EQ(abi_point_sum(std_::as_c(bad)), -5.0);
+
+    const abi_status ok = std_::as_c(std_::expected<void, std::int64_t>());
+    EXPECT_TRUE(STD_EXPECTED_C_HAS_VALUE(ok));
+    EXPECT_EQ(ok.tag, STD_EXPECTED_C_VALUE);
+}
+
+TEST(CResultTest, UnknownTagsReadAsErrors)
+{
+    abi_byte_result r = std_::as_c(std_::expected<std::uint8_t, std::uint16_t>(
+        std_::unexpected<std::uint16_t>(std::uint16_t{9})));
+    EXPECT_EQ(r.tag, STD_EXPECTED_C_ERROR);
+    r.tag = 77;
+    EXPECT_EQ(std_::from_c(r).error(), 9u);
+}
+
+TEST(CResultTest, ConversionsAreConstexpr)
+{
+    constexpr auto c = std_::as_c(std_::expected<int, int>(3));
+    static_assert(c.tag == STD_EXPECTED_C_VALUE && c.u.value == 3, "");
+    static_assert(*std_::from_c(c) == 3, "");
+    SUCCEED();
+}
@@ -532,6 +532,61 @@ TEST_F(ExpectedConstructorTest, MoveConstructor_ValidValue_WhenAvailable)
     EXPECT_EQ(*moved, "Hello World");
 }
 
+TEST_F(ExpectedConstructorTest, CopyConstructor_NonTrivialPayloads)
+{
+    std_::expected<std::string, MyError> value("payload");
+    std_::expected<std::string, MyError> error(std_::unexpected<MyError>(MyError{500, "Boom"}));
+
+    std_::expected<std::string, MyError> value_copy(value);
+    std_::expected<std::string, MyError> error_copy(error);
+
+    EXPECT_EQ(*value_copy, "payload");
+    EXPECT_EQ(*value, "payload");
+    EXPECT_EQ(error_copy.error(), MyError(500, "Boom"));
+    EXPECT_EQ(error.error(), MyError(500, "Boom"));
+}
+
+TEST_F(ExpectedConstructorTest, MoveConstructor_NonTrivialPayloads)
+{
+    std_::expected<std::string, MyError> value(std::string(64, 'v'));
+    std_::expected<NonCopyable, MyError> non_copyable(NonCopyable(7));
+
+    std_::expected<std::string, MyError> moved(std::move(value));
+    std_::expected<NonCopyable, MyError> moved_nc(std::move(non_copyable));
+
+    EXPECT_EQ(*moved, std::string(64, 'v'));
+    EXPECT_EQ(moved_nc->value, 7);
+
+    static_assert(std::is_nothrow_move_constructible<std_::expected<std::string, int>>::value,
+                  "Move constructor should be noexcept for nothrow-movable payloads");
+    static_assert(!std::is_copy_constructible<std_::expected<NonCopyable, MyError>>::value,
+                  "Copy constructor must be deleted for non-copyable T");
+    static_assert(std::is_trivially_copyable<std_::expected<int, long>>::value,
+                  "Trivial payloads keep expected trivially copyable");
+}
+
+TEST_F(ExpectedConstructorTest, Assignment_AcrossStates)
+{
+    std_::expected<std::string, MyError> a("first");
+    std_::expected<std::string, MyError> b(std_::unexpected<MyError>(MyError{1, "one"}));
+
+    a = b;
+    ASSERT_FALSE(a.has_value());
+    EXPECT_EQ(a.error(), MyError(1, "one"));
+
+    b = std_::expected<std::string, MyError>("second");
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ(*b, "second");
+
+    a = std::move(b);
+    ASSERT_TRUE(a.has_value());
+    EXPECT_EQ(*a, "second");
+
+    std_::expected<std::string, MyError> c("third");
+    a = c;
+    EXPECT_EQ(*a, "third");
+}
+
 TEST_F(ExpectedConstructorTest, ExceptionSafety_NoThrowConstructors)
 {
     static_assert(std::is_nothrow_default_constructible<std_::expected<int, MyError>>::value,
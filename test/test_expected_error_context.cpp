@@ -0,0 +1,128 @@
+#include <expected/error_context.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+
+std_::expected<int, std_::error_context> read_block(int shard, int block)
+{
+    if (block < 0)
+    {
+        return std_::unexpected<std_::error_context>(
+            std_::error_context("checksum mismatch at offset {}", block * -512));
+    }
+    return shard * 100 + block;
+}
+
+std_::expected<int, std_::error_context> load_shard(int shard)
+{
+    auto r = read_block(shard, -shard);
+    if (!r)
+    {
+        return std_::unexpected<std_::error_context>(
+            r.error().with_context("loading shard {}", shard));
+    }
+    return *r;
+}
+
+class ErrorContextTest : public ::testing::Test
+{
+protected:
+    std_::context_scope scope;
+};
+
+TEST_F(ErrorContextTest, StaysOnePointerWide)
+{
+    EXPECT_EQ(sizeof(std_::error_context), sizeof(void*));
+    EXPECT_TRUE(std::is_trivially_copyable<std_::error_context>::value);
+}
+
+TEST_F(ErrorContextTest, FormatsPlaceholders)
+{
+    std_::error_context ctx("{} of {} {} ({}) {{literal}}", 3, std::string("shards"), "failed", true);
+
+    EXPECT_EQ(ctx.message(), "3 of shards failed (true) {literal}");
+}
+
+TEST_F(ErrorContextTest, ExtraPlaceholdersArePrintedVerbatim)
+{
+    std_::error_context ctx("{} and {}", 1);
+
+    EXPECT_EQ(ctx.message(), "1 and {}");
+}
+
+TEST_F(ErrorContextTest, ChainsOutermostFirst)
+{
+    auto r = load_shard(7).transform_error(
+        [](const std_::error_context& e)
+        {
+            return e.with_context("request {}", "GET /index");
+        });
+
+    ASSERT_FALSE(r.has_value());
+    const auto& err = r.error();
+
+    std::vector<std::string> frames;
+    for (auto frame : err)
+    {
+        frames.emplace_back(frame);
+    }
+
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[0], "request GET /index");
+    EXPECT_EQ(frames[1], "loading shard 7");
+    EXPECT_EQ(frames[2], "checksum mismatch at offset 3584");
+    EXPECT_EQ(err.root_cause(), "checksum mismatch at offset 3584");
+    EXPECT_EQ(err.to_string(),
+              "request GET /index: loading shard 7: checksum mismatch at offset 3584");
+}
+
+TEST_F(ErrorContextTest, BranchesShareTail)
+{
+    std_::error_context base("disk full");
+    auto a = base.with_context("writing {}", "a");
+    auto b = base.with_context("writing {}", "b");
+
+    EXPECT_EQ(a.to_string(), "writing a: disk full");
+    EXPECT_EQ(b.to_string(), "writing b: disk full");
+    EXPECT_EQ(base.to_string(), "disk full");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a, base.with_context("writing a"));
+}
+
+TEST_F(ErrorContextTest, ScopeRewindsArena)
+{
+    auto& arena = std_::context_arena::local();
+    const auto before = arena.bytes_used();
+    {
+        std_::context_scope inner;
+        std_::error_context ctx("transient");
+        for (int i = 0; i < 64; ++i)
+        {
+            ctx = ctx.with_context("layer {}", i);
+        }
+        EXPECT_GT(arena.bytes_used(), before);
+    }
+    EXPECT_EQ(arena.bytes_used(), before);
+}
+
+TEST_F(ErrorContextTest, GrowsAcrossBlocks)
+{
+    std_::error_context ctx("root");
+    const std::string wide(400, 'x');
+    for (int i = 0; i < 200; ++i)
+    {
+        ctx = ctx.with_context("{} {}", i, wide);
+    }
+
+    std::size_t depth = 0;
+    for (auto frame : ctx)
+    {
+        (void)frame;
+        ++depth;
+    }
+    EXPECT_EQ(depth, 201u);
+    EXPECT_EQ(ctx.root_cause(), "root");
+    EXPECT_EQ(ctx.message().substr(0, 4), "199 ");
+}
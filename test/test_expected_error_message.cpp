@@ -0,0 +1,141 @@
+#include <expected/error_message.hpp>
+#include <expected/expected.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <type_traits>
+
+
+using TruncatingMessage = std_::basic_error_message<64, std_::overflow_policy::truncate>;
+
+constexpr std_::error_message kNotFound = std_::error_message::from_literal("not found");
+
+std_::expected<int, std_::error_message> lookup(int key)
+{
+    if (key < 0)
+    {
+        return std_::unexpected<std_::error_message>(
+            std_::error_message::from_literal("negative key"));
+    }
+    return key * 2;
+}
+
+TEST(ErrorMessageTest, FitsInOneCacheLine)
+{
+    EXPECT_EQ(sizeof(std_::error_message), 64u);
+    EXPECT_EQ(std_::error_message::inline_capacity, 61u);
+    EXPECT_TRUE(std::is_nothrow_move_constructible<std_::error_message>::value);
+}
+
+TEST(ErrorMessageTest, LiteralsAreReferencedNotCopied)
+{
+    static constexpr char text[] = "disk quota exceeded";
+    std_::error_message msg = std_::error_message::from_literal(text);
+
+    EXPECT_TRUE(msg.is_literal());
+    EXPECT_EQ(msg.data(), text);
+    EXPECT_EQ(msg.size(), sizeof(text) - 1);
+
+    static_assert(kNotFound.size() == 9, "from_literal must be usable in constant expressions");
+    EXPECT_EQ(kNotFound, "not found");
+
+    auto copy = msg;
+    EXPECT_EQ(copy.data(), text);
+}
+
+TEST(ErrorMessageTest, CharArraysAreCopiedUpToTheirNul)
+{
+    std_::error_message msg;
+    {
+        char buffer[64] = "timed out";
+        msg = buffer;
+        buffer[0] = 'X';
+    }
+
+    EXPECT_TRUE(msg.is_inline());
+    EXPECT_EQ(msg.size(), 9u);
+    EXPECT_EQ(msg, "timed out");
+
+    const char unterminated[4] = {'a', 'b', 'c', 'd'};
+    EXPECT_EQ(std_::error_message(unterminated).view(), "abcd");
+}
+
+TEST(ErrorMessageTest, ShortRuntimeTextStaysInline)
+{
+    const std::string text(48, 'x');
+    std_::error_message msg(text);
+
+    EXPECT_TRUE(msg.is_inline());
+    EXPECT_EQ(msg.view(), text);
+    EXPECT_EQ(msg.c_str()[48], '\0');
+
+    auto moved = std::move(msg);
+    EXPECT_EQ(moved.view(), text);
+}
+
+TEST(ErrorMessageTest, ExactCapacityStaysInline)
+{
+    const std::string text(std_::error_message::inline_capacity, 'y');
+    std_::error_message msg(text);
+
+    EXPECT_TRUE(msg.is_inline());
+    EXPECT_EQ(msg.str(), text);
+}
+
+TEST(ErrorMessageTest, LongTextSpillsToHeap)
+{
+    const std::string text(200, 'z');
+    std_::error_message msg(text);
+
+    EXPECT_TRUE(msg.is_heap());
+    EXPECT_EQ(msg.view(), text);
+
+    auto copy = msg;
+    EXPECT_TRUE(copy.is_heap());
+    EXPECT_NE(copy.data(), msg.data());
+    EXPECT_EQ(copy, msg);
+
+    const char* owned = msg.data();
+    auto moved = std::move(msg);
+    EXPECT_EQ(moved.data(), owned);
+    EXPECT_TRUE(msg.empty());
+}
+
+TEST(ErrorMessageTest, TruncatePolicyNeverAllocates)
+{
+    const std::string text(200, 'w');
+    TruncatingMessage msg(text);
+
+    EXPECT_TRUE(msg.is_inline());
+    EXPECT_EQ(msg.size(), TruncatingMessage::inline_capacity);
+    EXPECT_EQ(msg.view(), text.substr(0, TruncatingMessage::inline_capacity));
+}
+
+TEST(ErrorMessageTest, AssignmentAcrossRepresentations)
+{
+    std_::error_message msg(std::string(100, 'a'));
+    msg = std_::error_message::from_literal("literal");
+    EXPECT_TRUE(msg.is_literal());
+
+    msg = std_::error_message(std::string(100, 'b'));
+    EXPECT_TRUE(msg.is_heap());
+
+    std_::error_message small(std::string("small"));
+    msg = small;
+    EXPECT_TRUE(msg.is_inline());
+    EXPECT_EQ(msg, "small");
+}
+
+TEST(ErrorMessageTest, WorksAsExpectedError)
+{
+    auto ok = lookup(4);
+    auto bad = lookup(-1);
+
+    EXPECT_EQ(*ok, 8);
+    ASSERT_FALSE(bad.has_value());
+    EXPECT_TRUE(bad.error().is_literal());
+    EXPECT_EQ(bad.error(), "negative key");
+
+    auto copy = bad;
+    EXPECT_EQ(copy, bad);
+}
@@ -0,0 +1,120 @@
+#ifndef STD_EXPECTED_ERROR_TRACE
+    #define STD_EXPECTED_ERROR_TRACE 1
+#endif
+
+#include <expected/error_trace.hpp>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+
+struct IoError
+{
+    int code;
+
+    bool operator==(const IoError& other) const
+    {
+        return code == other.code;
+    }
+};
+
+std_::expected<int, std_::traced<IoError>> open_device(int code)
+{
+    if (code != 0)
+    {
+        return std_::make_traced_unexpected(IoError{code});
+    }
+    return 7;
+}
+
+class ErrorTraceTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std_::error_trace::set_sample_rate(0);
+    }
+
+    void TearDown() override
+    {
+        std_::error_trace::set_sample_rate(0);
+    }
+};
+
+TEST_F(ErrorTraceTest, RecordsConstructionSite)
+{
+    const auto line = __LINE__ + 1;
+    auto err = std_::make_traced_unexpected(IoError{5});
+
+    EXPECT_EQ(err.error().error().code, 5);
+    EXPECT_EQ(err.error().location().line(), line);
+    EXPECT_NE(std::strstr(err.error().location().file_name(), "test_expected_error_trace"),
+              nullptr);
+}
+
+TEST_F(ErrorTraceTest, PropagatesThroughExpected)
+{
+    auto result = open_device(3);
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().error().code, 3);
+    EXPECT_NE(std::strstr(result.error().location().function_name(), "open_device"), nullptr);
+
+    auto ok = open_device(0);
+    ASSERT_TRUE(ok.has_value());
+    EXPECT_EQ(*ok, 7);
+}
+
+TEST_F(ErrorTraceTest, NoBacktraceWhenSamplingDisabled)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        auto err = std_::make_traced_unexpected(IoError{i});
+        EXPECT_TRUE(err.error().backtrace().empty());
+    }
+}
+
+TEST_F(ErrorTraceTest, SamplesOneInN)
+{
+    std_::error_trace::set_sample_rate(4);
+
+    int sampled = 0;
+    for (int i = 0; i < 40; ++i)
+    {
+        auto err = std_::make_traced_unexpected(IoError{i});
+        if (!err.error().backtrace().empty())
+        {
+            ++sampled;
+        }
+    }
+
+    EXPECT_EQ(sampled, 10);
+}
+
+TEST_F(ErrorTraceTest, CopiesShareBacktrace)
+{
+    std_::error_trace::set_sample_rate(1);
+    auto err = std_::make_traced_unexpected(std::string("disk failure"));
+    auto view = err.error().backtrace();
+
+    std_::traced<std::string> copy = err.error();
+    EXPECT_EQ(copy.backtrace().frames, view.frames);
+    EXPECT_EQ(copy.backtrace().size, view.size);
+
+    std_::traced<std::string> moved = std::move(copy);
+    EXPECT_EQ(moved.backtrace().frames, view.frames);
+    EXPECT_TRUE(copy.backtrace().empty());
+    EXPECT_EQ(moved.error(), "disk failure");
+}
+
+TEST_F(ErrorTraceTest, ComparesByPayloadOnly)
+{
+    auto a = std_::make_traced_unexpected(IoError{1});
+    auto b = std_::make_traced_unexpected(IoError{1});
+    auto c = std_::make_traced_unexpected(IoError{2});
+
+    EXPECT_TRUE(a.error() == b.error());
+    EXPECT_FALSE(a.error() == c.error());
+}
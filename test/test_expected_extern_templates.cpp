@@ -0,0 +1,52 @@
+#include <expected/expected.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <system_error>
+
+
+// Built with STD_EXPECTED_EXTERN_TEMPLATES: the non-template members used here are not
+// instantiated in this TU, so each of them must come from lib_expected.
+
+TEST(ExternTemplatesTest, StringErrorSpecializations)
+{
+    std_::expected<int, std::string> ok(42);
+    std_::expected<int, std::string> bad(std_::unexpected<std::string>("bad input"));
+
+    EXPECT_EQ(ok.value(), 42);
+    EXPECT_EQ(bad.error(), "bad input");
+    EXPECT_THROW(bad.value(), std_::bad_expected_access<std::string>);
+
+    ok.swap(bad);
+    EXPECT_FALSE(ok.has_value());
+    EXPECT_EQ(*bad, 42);
+
+    std_::expected<std::string, std::string> text("payload");
+    auto copy = text;
+    copy = std_::unexpected<std::string>("overwritten");
+    EXPECT_EQ(*text, "payload");
+    EXPECT_EQ(copy.error(), "overwritten");
+
+    std_::expected<void, std::string> done;
+    std_::expected<void, std::string> failed(std_::unexpected<std::string>("no"));
+    done.swap(failed);
+    EXPECT_FALSE(done.has_value());
+    EXPECT_TRUE(failed.has_value());
+}
+
+TEST(ExternTemplatesTest, ErrorCodeSpecializations)
+{
+    const auto code = std::make_error_code(std::errc::no_such_file_or_directory);
+
+    std_::expected<int, std::error_code> count{std_::unexpected<std::error_code>(code)};
+    std_::expected<std::string, std::error_code> name("config.toml");
+    std_::expected<void, std::error_code> status;
+
+    EXPECT_EQ(count.error(), code);
+    EXPECT_EQ(name.value(), "config.toml");
+    EXPECT_TRUE(status.has_value());
+
+    status = std_::unexpected<std::error_code>(code);
+    EXPECT_EQ(status.error(), std::errc::no_such_file_or_directory);
+    EXPECT_EQ(count.error_or(std::error_code()), code);
+}
@@ -0,0 +1,166 @@
+#include <expected/hash.hpp>
+#include <expected/wire.hpp>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+namespace
+{
+
+struct point
+{
+    std::int32_t x;
+    std::int32_t y;
+};
+
+struct wide
+{
+    std::uint64_t a;
+    std::uint64_t b;
+    std::uint32_t c;
+    std::uint32_t d;
+};
+
+// Not byte-hashable (floating point) and no std::hash.
+struct reading
+{
+    double celsius;
+};
+
+// Byte-hashable layout, but equality and std::hash look at the id only.
+struct handle
+{
+    int id;
+    int generation;
+
+    friend bool operator==(const handle& a, const handle& b) noexcept
+    {
+        return a.id == b.id;
+    }
+};
+
+}  // namespace
+
+template <>
+struct std::hash<handle>
+{
+    std::size_t operator()(const handle& h) const noexcept
+    {
+        return std::hash<int>{}(h.id);
+    }
+};
+
+TEST(HashTest, ValuesAndErrorsAreDomainSeparated)
+{
+    std::hash<std_::expected<int, int>> h;
+    using result = std_::expected<int, int>;
+    EXPECT_NE(h(result(7)), h(result(std_::unexpected<int>(7))));
+    EXPECT_NE(h(result(0)), h(result(std_::unexpected<int>(0))));
+
+    std::hash<std_::expected<std::string, std::string>> hs;
+    EXPECT_NE(hs(std::string("x")), hs(std_::unexpected<std::string>("x")));
+}
+
+TEST(HashTest, UnexpectedHashesLikeTheErrorItEquals)
+{
+    const std_::unexpected<int> u(42);
+    const std_::expected<double, int> r = u;
+    ASSERT_TRUE(r == u);
+    const std::hash<std_::unexpected<int>> hash_error;
+    const std::hash<std_::expected<double, int>> hash_result;
+    EXPECT_EQ(hash_error(u), hash_result(r));
+}
+
+TEST(HashTest, TriviallyCopyablePayloadsNeedNoStdHash)
+{
+    using result = std_::expected<point, wide>;
+    std::hash<result> h;
+    EXPECT_EQ(h(point{1, 2}), h(point{1, 2}));
+    EXPECT_NE(h(point{1, 2}), h(point{2, 1}));
+    EXPECT_NE(h(std_::unexpected<wide>(wide{1, 2, 3, 4})),
+              h(std_::unexpected<wide>(wide{1, 2, 3, 5})));
+
+    const std_::expected<void, int> done;
+    const std::hash<std_::expected<void, int>> hash_void;
+    EXPECT_EQ(hash_void(done), std_::hash_value(done));
+}
+
+TEST(HashTest, PayloadStdHashTakesPrecedenceOverBytes)
+{
+    using result = std_::expected<handle, handle>;
+    const result a(handle{1, 1});
+    const result b(handle{1, 2});
+    ASSERT_TRUE(a == b);
+    std::hash<result> h;
+    EXPECT_EQ(h(a), h(b));
+    EXPECT_EQ(h(std_::unexpected<handle>(handle{3, 1})), h(std_::unexpected<handle>(handle{3, 7})));
+
+    std::unordered_set<result> seen{a, b, result(handle{2, 1})};
+    EXPECT_EQ(seen.size(), 2u);
+}
+
+TEST(HashTest, KeysUnorderedContainers)
+{
+    std::unordered_map<std_::expected<int, std::string>, int> outcomes;
+    ++outcomes[std_::unexpected<std::string>("timeout")];
+    ++outcomes[std_::unexpected<std::string>("timeout")];
+    ++outcomes[3];
+    EXPECT_EQ(outcomes.size(), 2u);
+    EXPECT_EQ((outcomes[std_::unexpected<std::string>("timeout")]), 2);
+
+    std::unordered_set<std_::unexpected<int>> errors{std_::unexpected<int>(1),
+                                                     std_::unexpected<int>(1)};
+    EXPECT_EQ(errors.size(), 1u);
+}
+
+TEST(HashTest, DisabledWithoutAHashablePayload)
+{
+    EXPECT_FALSE((std::is_default_constructible<std::hash<std_::expected<reading, int>>>::value));
+    EXPECT_FALSE((std::is_default_constructible<std::hash<std_::expected<int, reading>>>::value));
+    EXPECT_FALSE((std::is_default_constructible<std::hash<std_::unexpected<reading>>>::value));
+    EXPECT_TRUE((std::is_default_constructible<std::hash<std_::expected<double, int>>>::value));
+    EXPECT_TRUE((std::is_default_constructible<std::hash<std_::expected<void, int>>>::value));
+}
+
+TEST(HashBatchTest, MatchesPerItemHashes)
+{
+    std::vector<std_::expected<std::int64_t, std::int32_t>> results;
+    for (int i = 0; i < 200; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            results.push_back(std_::unexpected<std::int32_t>(i));
+        }
+        else
+        {
+            results.push_back(std::int64_t{i} * 1'000);
+        }
+    }
+
+    std::vector<std::size_t> direct(results.size());
+    std_::hash_batch(std::span<const std_::expected<std::int64_t, std::int32_t>>(results),
+                     std::span<std::size_t>(direct));
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(direct[i], std_::hash_value(results[i])) << i;
+    }
+
+    const std::vector<std::byte> buffer =
+        std_::wire::encode_batch(
+            std::span<const std_::expected<std::int64_t, std::int32_t>>(results))
+            .value();
+    auto view = std_::wire::batch_view<std::int64_t, std::int32_t>::parse(buffer);
+    ASSERT_TRUE(view.has_value());
+
+    std::vector<std::size_t> packed(results.size());
+    std_::hash_batch(*view, std::span<std::size_t>(packed));
+    EXPECT_EQ(packed, direct);
+}
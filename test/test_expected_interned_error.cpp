@@ -0,0 +1,151 @@
+#include <expected/expected.hpp>
+#include <expected/interned_error.hpp>
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace
+{
+
+// Interned during static initialisation.
+const std_::interned_error kTimeout = std_::interned_error::from_literal("operation timed out");
+const std_::interned_error kRefused("connection refused");
+
+std_::expected<int, std_::interned_error> connect(int port)
+{
+    if (port == 0)
+    {
+        return std_::unexpected<std_::interned_error>(kRefused);
+    }
+    return port;
+}
+
+}  // namespace
+
+TEST(InternedErrorTest, IsFourByteTriviallyCopyable)
+{
+    EXPECT_EQ(sizeof(std_::interned_error), 4u);
+    EXPECT_TRUE(std::is_trivially_copyable<std_::interned_error>::value);
+    EXPECT_FALSE(std_::interned_error().valid());
+    EXPECT_TRUE(std_::interned_error().message().empty());
+}
+
+TEST(InternedErrorTest, StaticInitLiteralsAreInterned)
+{
+    ASSERT_TRUE(kTimeout.valid());
+    EXPECT_EQ(kTimeout.message(), "operation timed out");
+    EXPECT_NE(kTimeout, kRefused);
+}
+
+TEST(InternedErrorTest, SameTextYieldsSameId)
+{
+    const std::string runtime = std::string("operation ") + "timed out";
+    std_::interned_error again(runtime);
+
+    EXPECT_EQ(again, kTimeout);
+    EXPECT_EQ(again.id(), kTimeout.id());
+    EXPECT_EQ(std_::interned_error::from_id(kTimeout.id()).message(), "operation timed out");
+}
+
+TEST(InternedErrorTest, RuntimeTextIsCopied)
+{
+    std::string text = "transient " + std::to_string(42);
+    std_::interned_error err(text);
+    text.assign("overwritten");
+
+    EXPECT_EQ(err.message(), "transient 42");
+}
+
+TEST(InternedErrorTest, CharBuffersAreCopiedUpToTheirNul)
+{
+    std_::interned_error err;
+    {
+        char buffer[64] = "buffered failure";
+        err = std_::interned_error(buffer);
+        buffer[0] = 'X';
+    }
+
+    EXPECT_EQ(err.message(), "buffered failure");
+    EXPECT_EQ(err, std_::interned_error::from_literal("buffered failure"));
+}
+
+TEST(InternedErrorTest, ExpectedComparesById)
+{
+    auto a = connect(0);
+    auto b = connect(0);
+
+    ASSERT_FALSE(a.has_value());
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.error().message(), "connection refused");
+    EXPECT_EQ(*connect(80), 80);
+}
+
+TEST(InternedErrorTest, ConcurrentInterningAgrees)
+{
+    constexpr int kThreads = 8;
+    constexpr int kMessages = 200;
+    std::vector<std::vector<std::uint32_t>> ids(kThreads);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        workers.emplace_back(
+            [t, &ids]
+            {
+                for (int i = 0; i < kMessages; ++i)
+                {
+                    const int n = (i * 7 + t) % kMessages;
+                    std_::interned_error err("concurrent message " + std::to_string(n));
+                    ids[static_cast<std::size_t>(t)].push_back(err.id());
+                }
+            });
+    }
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+
+    std::set<std::uint32_t> distinct;
+    for (const auto& per_thread : ids)
+    {
+        distinct.insert(per_thread.begin(), per_thread.end());
+    }
+    EXPECT_EQ(distinct.size(), static_cast<std::size_t>(kMessages));
+    EXPECT_EQ(distinct.count(0u), 0u);
+
+    for (int n = 0; n < kMessages; ++n)
+    {
+        const std::string text = "concurrent message " + std::to_string(n);
+        EXPECT_EQ(std_::interned_error(text).message(), text);
+    }
+}
+
+// Runs last: it leaves the process-wide table full.
+TEST(InternedErrorTest, OverflowNeverComparesEqual)
+{
+    const auto overflow = std_::interned_error::from_id(std_::interned_error::overflow_id);
+    EXPECT_NE(overflow, overflow);
+    EXPECT_FALSE(overflow.valid());
+
+    const std::size_t capacity = std_::interned_error::table_capacity;
+    for (std::size_t n = 0; std_::interned_error::interned_count() < capacity; ++n)
+    {
+        ASSERT_TRUE(std_::interned_error("filler " + std::to_string(n)).valid());
+    }
+
+    const std_::interned_error a("one message too many");
+    const std_::interned_error b("another message too many");
+    EXPECT_TRUE(a.overflowed());
+    EXPECT_TRUE(b.overflowed());
+    EXPECT_NE(a, b);
+    EXPECT_NE(a, a);
+    EXPECT_NE(a, std_::interned_error());
+    EXPECT_FALSE(a.message().empty());
+
+    EXPECT_EQ(std_::interned_error("operation timed out"), kTimeout);
+}
@@ -0,0 +1,231 @@
+#include <expected/io.hpp>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+
+class TempFileTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        char name[] = "/tmp/std_expected_io_XXXXXX";
+        int fd = ::mkstemp(name);
+        ASSERT_GE(fd, 0);
+        ::close(fd);
+        path_ = name;
+    }
+
+    void TearDown() override
+    {
+        std::remove(path_.c_str());
+    }
+
+    void write_file(const std::string& contents)
+    {
+        std::FILE* f = std::fopen(path_.c_str(), "wb");
+        ASSERT_NE(f, nullptr);
+        std::fwrite(contents.data(), 1, contents.size(), f);
+        std::fclose(f);
+    }
+
+    std::string path_;
+};
+
+TEST_F(TempFileTest, MapsContentsWithoutCopying)
+{
+    write_file("first line\nsecond line\n");
+
+    auto mapped = std_::map_file(path_);
+    ASSERT_TRUE(mapped.has_value()) << mapped.error().op_name();
+    ASSERT_EQ(mapped->size(), 23u);
+
+    auto bytes = mapped->bytes();
+    EXPECT_EQ(std::memcmp(bytes.data(), "first line\n", 11), 0);
+    EXPECT_EQ(static_cast<char>(bytes.back()), '\n');
+}
+
+TEST_F(TempFileTest, EmptyFileGivesEmptyMapping)
+{
+    auto mapped = std_::map_file(path_, std_::access_hint::random);
+    ASSERT_TRUE(mapped.has_value());
+    EXPECT_TRUE(mapped->empty());
+    EXPECT_TRUE(mapped->bytes().empty());
+    EXPECT_TRUE(mapped->advise(std_::access_hint::willneed).has_value());
+}
+
+TEST_F(TempFileTest, MovingTransfersOwnership)
+{
+    write_file(std::string(10000, 'x'));
+
+    auto mapped = std_::map_file(path_.c_str());
+    ASSERT_TRUE(mapped.has_value());
+    const std::byte* data = mapped->data();
+
+    std_::mapped_file owner = std::move(*mapped);
+    EXPECT_EQ(owner.data(), data);
+    EXPECT_EQ(owner.size(), 10000u);
+    EXPECT_TRUE(mapped->empty());
+
+    EXPECT_TRUE(owner.advise(std_::access_hint::random).has_value());
+    EXPECT_EQ(static_cast<char>(owner.bytes()[9999]), 'x');
+}
+
+TEST(MapFileErrorTest, MissingFileReportsOpenAndErrno)
+{
+    auto mapped = std_::map_file("/nonexistent/std_expected/file");
+    ASSERT_FALSE(mapped.has_value());
+    EXPECT_EQ(mapped.error(), std_::io_error(std_::io_op::open, ENOENT));
+    EXPECT_STREQ(mapped.error().op_name(), "open");
+    EXPECT_EQ(mapped.error().code(), std::errc::no_such_file_or_directory);
+}
+
+TEST(MapFileErrorTest, DirectoryIsRejected)
+{
+    auto mapped = std_::map_file("/tmp");
+    ASSERT_FALSE(mapped.has_value());
+    EXPECT_EQ(mapped.error().value(), EISDIR);
+}
+
+TEST(MapFileErrorTest, IoErrorIsSmallAndTrivial)
+{
+    static_assert(std::is_trivially_copyable<std_::io_error>::value, "");
+    static_assert(sizeof(std_::io_error) <= 8, "");
+    EXPECT_EQ(std_::io_error(std_::io_op::read, EIO).code().value(), EIO);
+}
+
+TEST_F(TempFileTest, LineReaderYieldsLinesThenEndOfFile)
+{
+    write_file("alpha\n\nbeta\ngamma");
+
+    auto reader = std_::line_reader::open(path_.c_str());
+    ASSERT_TRUE(reader.has_value());
+
+    std::vector<std::string> lines;
+    auto line = reader->next();
+    for (; line; line = reader->next())
+    {
+        lines.emplace_back(*line);
+    }
+    EXPECT_TRUE(line.error().is_eof());
+    EXPECT_EQ(line.error(), std_::io_error::end_of_file());
+    EXPECT_EQ(lines, (std::vector<std::string>{"alpha", "", "beta", "gamma"}));
+    EXPECT_EQ(reader->bytes_read(), 17u);
+
+    // Exhausted readers keep reporting the end.
+    EXPECT_TRUE(reader->next().error().is_eof());
+}
+
+TEST_F(TempFileTest, LineReaderGrowsForLinesLongerThanTheBuffer)
+{
+    std::string contents;
+    for (int i = 0; i < 3000; ++i)
+    {
+        contents += std::to_string(i) + '\n';
+    }
+    const std::string long_line(200000, 'L');
+    contents += long_line + "\ntail\n";
+    write_file(contents);
+
+    std_::reader_options options;
+    options.buffer_size = 1;  // rounded up to the minimum
+    auto reader = std_::line_reader::open(path_.c_str(), options);
+    ASSERT_TRUE(reader.has_value());
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        auto line = reader->next();
+        ASSERT_TRUE(line.has_value());
+        ASSERT_EQ(*line, std::to_string(i));
+    }
+    auto line = reader->next();
+    ASSERT_TRUE(line.has_value());
+    EXPECT_EQ(line->size(), long_line.size());
+    EXPECT_EQ(*reader->next(), "tail");
+    EXPECT_TRUE(reader->next().error().is_eof());
+}
+
+TEST_F(TempFileTest, LineReaderReadsLengthPrefixedRecords)
+{
+    std::string contents;
+    for (const std::string& payload : {std::string("one"), std::string(), std::string(70000, 'r')})
+    {
+        const auto length = static_cast<std::uint32_t>(payload.size());
+        contents.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        contents += payload;
+    }
+    const std::uint32_t truncated = 10;
+    contents.append(reinterpret_cast<const char*>(&truncated), sizeof(truncated));
+    contents += "abc";
+    write_file(contents);
+
+    std_::reader_options options;
+    options.format = std_::record_format::length_prefixed;
+    auto reader = std_::line_reader::open(path_.c_str(), options);
+    ASSERT_TRUE(reader.has_value());
+
+    EXPECT_EQ(*reader->next(), "one");
+    EXPECT_EQ(*reader->next(), "");
+    EXPECT_EQ(reader->next()->size(), 70000u);
+
+    auto bad = reader->next();
+    ASSERT_FALSE(bad.has_value());
+    EXPECT_EQ(bad.error(), std_::io_error(std_::io_op::read, EBADMSG));
+    EXPECT_TRUE(reader->next().error().is_eof());
+}
+
+TEST_F(TempFileTest, LineReaderRejectsRecordsOverMaxRecord)
+{
+    std::string contents;
+    const std::uint32_t corrupt = 0xFFFF'FFF0u;
+    contents.append(reinterpret_cast<const char*>(&corrupt), sizeof(corrupt));
+    contents += "payload";
+    write_file(contents);
+
+    std_::reader_options options;
+    options.format = std_::record_format::length_prefixed;
+    options.max_record = 1 << 16;
+    auto records = std_::line_reader::open(path_.c_str(), options);
+    ASSERT_TRUE(records.has_value());
+    EXPECT_EQ(records->next().error(), std_::io_error(std_::io_op::read, EMSGSIZE));
+
+    write_file(std::string(100'000, 'z') + "\n");
+    options.format = std_::record_format::lines;
+    options.buffer_size = 16 * 1'024;
+    auto lines = std_::line_reader::open(path_.c_str(), options);
+    ASSERT_TRUE(lines.has_value());
+    EXPECT_EQ(lines->next().error(), std_::io_error(std_::io_op::read, EMSGSIZE));
+}
+
+TEST(LineReaderTest, ReadsFromBorrowedDescriptor)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    const char text[] = "x\ny\n";
+    ASSERT_EQ(::write(fds[1], text, 4), 4);
+    ::close(fds[1]);
+
+    {
+        std_::line_reader reader(fds[0]);
+        EXPECT_EQ(*reader.next(), "x");
+        std_::line_reader moved = std::move(reader);
+        EXPECT_EQ(*moved.next(), "y");
+        EXPECT_TRUE(moved.next().error().is_eof());
+        EXPECT_EQ(reader.next().error().value(), EBADF);
+    }
+    // Not closed by the reader.
+    EXPECT_EQ(::close(fds[0]), 0);
+}
+
+TEST(LineReaderTest, OpenReportsMissingFile)
+{
+    auto reader = std_::line_reader::open("/nonexistent/std_expected/log");
+    ASSERT_FALSE(reader.has_value());
+    EXPECT_EQ(reader.error(), std_::io_error(std_::io_op::open, ENOENT));
+}
@@ -0,0 +1,296 @@
+#include <expected/memoize.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+
+// Manually advanced clock, so that expiry is tested without sleeping.
+struct test_clock
+{
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<test_clock>;
+    static constexpr bool is_steady = true;
+
+    static inline std::atomic<rep> ticks{0};
+
+    static time_point now() noexcept { return time_point(duration(ticks.load())); }
+
+    static void advance(std::chrono::nanoseconds by) { ticks += by.count(); }
+};
+
+struct counting_lookup
+{
+    std::atomic<int>* calls;
+
+    std_::expected<int, std::string> operator()(const int& key) const
+    {
+        ++*calls;
+        if (key < 0)
+        {
+            return std_::unexpected<std::string>("negative");
+        }
+        return key * 10;
+    }
+};
+
+std_::memoize_options small_options()
+{
+    std_::memoize_options options;
+    options.values = {std::chrono::seconds(60), 64};
+    options.errors = {std::chrono::seconds(1), 64};
+    options.shards = 4;
+    return options;
+}
+
+using test_memoize = std_::memoize<counting_lookup, int, std::hash<int>, test_clock>;
+
+// A value whose copies throw while armed; moves never do.
+struct fragile
+{
+    static inline std::atomic<bool> armed{false};
+
+    int value = 0;
+
+    fragile() = default;
+    explicit fragile(int v) : value(v) {}
+    fragile(fragile&&) noexcept = default;
+    fragile& operator=(fragile&&) noexcept = default;
+
+    fragile(const fragile& rhs) : value(rhs.value)
+    {
+        if (armed)
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    fragile& operator=(const fragile& rhs)
+    {
+        fragile copy(rhs);
+        value = copy.value;
+        return *this;
+    }
+};
+
+}  // namespace
+
+TEST(MemoizeTest, KeyIsDeducedFromTheFunction)
+{
+    std_::memoize square(
+        [](const long& x) -> std_::expected<long, int>
+        {
+            return x * x;
+        });
+    static_assert(std::is_same<decltype(square)::key_type, long>::value, "");
+    EXPECT_EQ(*square(7), 49);
+}
+
+TEST(MemoizeTest, CachesValuesAndErrors)
+{
+    std::atomic<int> calls{0};
+    test_memoize lookup(counting_lookup{&calls}, small_options());
+
+    EXPECT_EQ(*lookup(4), 40);
+    EXPECT_EQ(*lookup(4), 40);
+    EXPECT_EQ(lookup(-1).error(), "negative");
+    EXPECT_EQ(lookup(-1).error(), "negative");
+    EXPECT_EQ(calls.load(), 2);
+
+    const std_::memoize_stats stats = lookup.stats();
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.error_hits, 1u);
+}
+
+TEST(MemoizeTest, ErrorsExpireOnTheirOwnTtl)
+{
+    std::atomic<int> calls{0};
+    test_memoize lookup(counting_lookup{&calls}, small_options());
+
+    lookup(5);
+    lookup(-5);
+    test_clock::advance(std::chrono::seconds(2));
+    lookup(5);   // value TTL is a minute: still cached
+    lookup(-5);  // error TTL is a second: computed again
+    EXPECT_EQ(calls.load(), 3);
+
+    test_clock::advance(std::chrono::minutes(2));
+    lookup(5);
+    EXPECT_EQ(calls.load(), 4);
+}
+
+TEST(MemoizeTest, SeparateCapacitiesKeepErrorsFromEvictingValues)
+{
+    std_::memoize_options options = small_options();
+    options.shards = 1;
+    options.values.capacity = 2;
+    options.errors.capacity = 1;
+    std::atomic<int> calls{0};
+    test_memoize lookup(counting_lookup{&calls}, options);
+
+    lookup(1);
+    lookup(2);
+    for (int k = -1; k > -10; --k)
+    {
+        lookup(k);
+    }
+    calls = 0;
+    lookup(1);
+    lookup(2);
+    EXPECT_EQ(calls.load(), 0);
+    EXPECT_EQ(lookup.stats().evictions, 8u);
+
+    lookup(1);  // most recently used, so 2 is evicted next
+    lookup(3);
+    lookup(1);
+    EXPECT_EQ(calls.load(), 1);
+    lookup(2);
+    EXPECT_EQ(calls.load(), 2);
+}
+
+TEST(MemoizeTest, ZeroCapacityDisablesCaching)
+{
+    std_::memoize_options options = small_options();
+    options.errors.capacity = 0;
+    std::atomic<int> calls{0};
+    test_memoize lookup(counting_lookup{&calls}, options);
+
+    lookup(-3);
+    lookup(-3);
+    EXPECT_EQ(calls.load(), 2);
+}
+
+TEST(MemoizeTest, InvalidateAndClear)
+{
+    std::atomic<int> calls{0};
+    test_memoize lookup(counting_lookup{&calls}, small_options());
+
+    lookup(1);
+    lookup(2);
+    lookup.invalidate(1);
+    lookup(1);
+    lookup(2);
+    EXPECT_EQ(calls.load(), 3);
+
+    lookup.clear();
+    lookup(2);
+    EXPECT_EQ(calls.load(), 4);
+}
+
+TEST(MemoizeTest, ConcurrentCallersShareOneComputation)
+{
+    std::atomic<int> calls{0};
+    std::atomic<bool> release{false};
+    auto slow = [&calls, &release](const int& key) -> std_::expected<int, int>
+    {
+        ++calls;
+        while (!release.load())
+        {
+            std::this_thread::yield();
+        }
+        return key + 1;
+    };
+    std_::memoize lookup(slow);
+
+    std::vector<std::thread> threads;
+    std::atomic<int> sum{0};
+    for (int i = 0; i < 8; ++i)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                sum += *lookup(41);
+            });
+    }
+    while (lookup.stats().misses + lookup.stats().coalesced < 8)
+    {
+        std::this_thread::yield();
+    }
+    release = true;
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(sum.load(), 8 * 42);
+    EXPECT_EQ(lookup.stats().coalesced, 7u);
+}
+
+TEST(MemoizeTest, ExceptionsPropagateAndAreNotCached)
+{
+    int calls = 0;
+    std_::memoize lookup(
+        [&calls](const int&) -> std_::expected<int, int>
+        {
+            if (++calls == 1)
+            {
+                throw std::runtime_error("store offline");
+            }
+            return 1;
+        });
+
+    EXPECT_THROW(lookup(0), std::runtime_error);
+    EXPECT_EQ(*lookup(0), 1);
+}
+
+TEST(MemoizeTest, FailureToCacheReleasesWaiters)
+{
+    std::atomic<int> calls{0};
+    std::atomic<bool> release{false};
+    std_::memoize lookup(
+        [&calls, &release](const int& key) -> std_::expected<fragile, int>
+        {
+            ++calls;
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+            return fragile(key);
+        });
+
+    fragile::armed = true;
+    std::atomic<int> failures{0};
+    auto call = [&lookup, &failures]
+    {
+        try
+        {
+            (void)lookup(3);
+        }
+        catch (const std::bad_alloc&)
+        {
+            ++failures;
+        }
+    };
+    std::thread owner(call);
+    while (calls == 0)
+    {
+        std::this_thread::yield();
+    }
+    std::thread waiter(call);
+    while (lookup.stats().coalesced == 0)
+    {
+        std::this_thread::yield();
+    }
+    release = true;
+    owner.join();
+    waiter.join();
+    EXPECT_EQ(failures, 2);
+
+    fragile::armed = false;
+    EXPECT_EQ(lookup(3)->value, 3);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(lookup(3)->value, 3);
+    EXPECT_EQ(calls, 2);
+}
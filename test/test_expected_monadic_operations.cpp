@@ -313,6 +313,26 @@ TEST_F(ExpectedMonadicTest, EdgeCase_ConstExpected)
     EXPECT_EQ(const_error.error_or(ParseError{"default"}).message, "error");
 }
 
+TEST_F(ExpectedMonadicTest, TransformError_KeepsValue)
+{
+    std_::expected<int, ParseError> success(42);
+    std_::expected<int, ParseError> error(std_::unexpected<ParseError>(ParseError{"bad", 3}));
+    const auto to_line = [](const ParseError& e)
+    {
+        return e.line;
+    };
+
+    std_::expected<int, int> mapped_success = success.transform_error(to_line);
+    std_::expected<int, int> mapped_error = error.transform_error(to_line);
+    std_::expected<int, int> moved = std::move(success).transform_error(to_line);
+
+    ASSERT_TRUE(mapped_success.has_value());
+    EXPECT_EQ(*mapped_success, 42);
+    EXPECT_EQ(*moved, 42);
+    ASSERT_FALSE(mapped_error.has_value());
+    EXPECT_EQ(mapped_error.error(), 3);
+}
+
 TEST_F(ExpectedMonadicTest, RealWorld_ConfigurationParsing)
 {
     struct Config
@@ -0,0 +1,126 @@
+#include <expected/parse.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+
+using std_::parse;
+using std_::parse_errc;
+using std_::parse_error;
+
+TEST(ParseTest, Integers)
+{
+    EXPECT_EQ(*parse<int>("0"), 0);
+    EXPECT_EQ(*parse<int>("-42"), -42);
+    EXPECT_EQ(*parse<unsigned>("4294967295"), 4294967295u);
+    EXPECT_EQ(*parse<std::int64_t>("-9223372036854775808"),
+              std::numeric_limits<std::int64_t>::min());
+    EXPECT_EQ(*parse<std::uint8_t>("255"), 255u);
+}
+
+TEST(ParseTest, EightAndSixteenDigitFastPath)
+{
+    EXPECT_EQ(*parse<int>("12345678"), 12345678);
+    EXPECT_EQ(*parse<int>("-87654321"), -87654321);
+    EXPECT_EQ(*parse<int>("00000042"), 42);
+    EXPECT_EQ(*parse<std::uint64_t>("1234567890123456"), 1234567890123456u);
+    EXPECT_EQ(*parse<std::int64_t>("-9999999999999999"), -9999999999999999);
+
+    // Same results as from_chars for every digit position.
+    for (int i = 0; i < 8; ++i)
+    {
+        std::string digits = "10000000";
+        digits[static_cast<std::size_t>(i)] = '9';
+        EXPECT_EQ(*parse<int>(digits), std::stoi(digits)) << digits;
+    }
+
+    EXPECT_EQ(parse<std::int16_t>("12345678").error(), (parse_error{parse_errc::out_of_range, 0}));
+    EXPECT_EQ(parse<std::int32_t>("1234567890123456").error().code, parse_errc::out_of_range);
+    EXPECT_EQ(parse<int>("1234567a").error(), (parse_error{parse_errc::invalid_character, 7}));
+    EXPECT_EQ(parse<int>("1234:678").error(), (parse_error{parse_errc::invalid_character, 4}));
+    EXPECT_EQ(parse<unsigned>("-1234567").error(), (parse_error{parse_errc::invalid_character, 0}));
+}
+
+TEST(ParseTest, ErrorsCarryCodeAndPosition)
+{
+    EXPECT_EQ(parse<int>("").error(), (parse_error{parse_errc::empty, 0}));
+    EXPECT_EQ(parse<int>("12x").error(), (parse_error{parse_errc::invalid_character, 2}));
+    EXPECT_EQ(parse<int>("x12").error(), (parse_error{parse_errc::invalid_character, 0}));
+    EXPECT_EQ(parse<int>("-").error(), (parse_error{parse_errc::invalid_character, 1}));
+    EXPECT_EQ(parse<int>(" 1").error(), (parse_error{parse_errc::invalid_character, 0}));
+    EXPECT_EQ(parse<int>("99999999999").error(), (parse_error{parse_errc::out_of_range, 0}));
+    EXPECT_EQ(parse<std::uint8_t>("256").error().code, parse_errc::out_of_range);
+}
+
+TEST(ParseTest, FloatingPoint)
+{
+    EXPECT_DOUBLE_EQ(*parse<double>("3.25"), 3.25);
+    EXPECT_DOUBLE_EQ(*parse<double>("-1e-3"), -0.001);
+    EXPECT_FLOAT_EQ(*parse<float>("0.5"), 0.5f);
+    EXPECT_EQ(parse<double>("1.5.2").error(), (parse_error{parse_errc::invalid_character, 3}));
+    EXPECT_EQ(parse<double>("1e999").error().code, parse_errc::out_of_range);
+}
+
+TEST(ParseTest, Booleans)
+{
+    EXPECT_TRUE(*parse<bool>("true"));
+    EXPECT_TRUE(*parse<bool>("1"));
+    EXPECT_FALSE(*parse<bool>("false"));
+    EXPECT_FALSE(*parse<bool>("0"));
+    EXPECT_EQ(parse<bool>("yes").error().code, parse_errc::invalid_character);
+}
+
+TEST(ParseTest, ComposesWithMonadicOperations)
+{
+    auto doubled = parse<int>("21").transform(
+        [](int v)
+        {
+            return v * 2;
+        });
+    EXPECT_EQ(*doubled, 42);
+
+    auto message = parse<int>("abc").transform_error(
+        [](parse_error e)
+        {
+            return std::string("bad number at ") + std::to_string(e.position);
+        });
+    EXPECT_EQ(message.error(), "bad number at 0");
+}
+
+TEST(ParseManyTest, FillsTheOutputSpan)
+{
+    int out[8];
+    auto n = std_::parse_many<int>("1,-2,12345678,4", ',', std::span<int>(out));
+    ASSERT_TRUE(n.has_value());
+    EXPECT_EQ(*n, 4u);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], -2);
+    EXPECT_EQ(out[2], 12345678);
+    EXPECT_EQ(out[3], 4);
+}
+
+TEST(ParseManyTest, AllowsOneTrailingDelimiter)
+{
+    auto values = std_::parse_many<double>("1.5\n2.5\n", '\n');
+    ASSERT_TRUE(values.has_value());
+    EXPECT_EQ(*values, (std::vector<double>{1.5, 2.5}));
+
+    EXPECT_TRUE(std_::parse_many<int>("", ',')->empty());
+}
+
+TEST(ParseManyTest, ErrorPositionIsRelativeToTheBuffer)
+{
+    auto bad = std_::parse_many<int>("10,20,3x,40", ',');
+    ASSERT_FALSE(bad.has_value());
+    EXPECT_EQ(bad.error(), (parse_error{parse_errc::invalid_character, 7}));
+
+    auto gap = std_::parse_many<int>("10,,30", ',');
+    EXPECT_EQ(gap.error(), (parse_error{parse_errc::empty, 3}));
+
+    int two[2];
+    auto full = std_::parse_many<int>("1,2,3", ',', std::span<int>(two));
+    EXPECT_EQ(full.error(), (parse_error{parse_errc::too_many_values, 4}));
+}
@@ -0,0 +1,138 @@
+#include <expected/shared_error.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using SharedMessage = std_::shared_error<std::string>;
+using LocalMessage = std_::shared_error<std::string, std_::local_refcount>;
+
+std_::expected<int, SharedMessage> fail_with(const char* text)
+{
+    return std_::unexpected<SharedMessage>(std_::make_shared_error<std::string>(text));
+}
+
+TEST(SharedErrorTest, PayloadIsImmutable)
+{
+    auto err = std_::make_shared_error<std::string>("read-only");
+
+    static_assert(std::is_same<decltype(err.get()), const std::string&>::value,
+                  "shared_error must only expose const access");
+    EXPECT_EQ(*err, "read-only");
+    EXPECT_EQ(err->size(), 9u);
+    EXPECT_EQ(sizeof(err), sizeof(void*));
+}
+
+TEST(SharedErrorTest, CopyingExpectedBumpsRefcount)
+{
+    auto result = fail_with("connection reset");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().use_count(), 1u);
+
+    auto copy = result;
+    EXPECT_EQ(result.error().use_count(), 2u);
+    EXPECT_EQ(copy.error().identity(), result.error().identity());
+
+    {
+        std::vector<std_::expected<int, SharedMessage>> consumers(8, result);
+        EXPECT_EQ(result.error().use_count(), 10u);
+    }
+    EXPECT_EQ(result.error().use_count(), 2u);
+}
+
+TEST(SharedErrorTest, LvalueMonadicOpsShareThePayload)
+{
+    auto result = fail_with("timeout");
+    const void* id = result.error().identity();
+
+    auto chained = result.and_then(
+        [](int v)
+        {
+            return std_::expected<long, SharedMessage>(v * 2L);
+        });
+    auto mapped = result.transform(
+        [](int v)
+        {
+            return v + 1;
+        });
+    auto recovered = result.or_else(
+        [](const SharedMessage& e)
+        {
+            return std_::expected<int, SharedMessage>(std_::unexpected<SharedMessage>(e));
+        });
+
+    EXPECT_EQ(chained.error().identity(), id);
+    EXPECT_EQ(mapped.error().identity(), id);
+    EXPECT_EQ(recovered.error().identity(), id);
+    EXPECT_EQ(result.error().use_count(), 4u);
+}
+
+TEST(SharedErrorTest, RvalueOpsMoveTheHandle)
+{
+    auto result = fail_with("gone");
+    const void* id = result.error().identity();
+
+    auto chained = std::move(result).and_then(
+        [](int v)
+        {
+            return std_::expected<int, SharedMessage>(v);
+        });
+
+    EXPECT_EQ(chained.error().identity(), id);
+    EXPECT_EQ(chained.error().use_count(), 1u);
+}
+
+TEST(SharedErrorTest, EqualityByIdentityThenPayload)
+{
+    auto a = std_::make_shared_error<std::string>("same");
+    auto b = std_::make_shared_error<std::string>("same");
+    auto c = std_::make_shared_error<std::string>("other");
+    auto a2 = a;
+
+    EXPECT_TRUE(a == a2);
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a != c);
+
+    std_::expected<int, SharedMessage> ea{std_::unexpected<SharedMessage>(a)};
+    std_::expected<int, SharedMessage> eb{std_::unexpected<SharedMessage>(b)};
+    EXPECT_TRUE(ea == eb);
+}
+
+TEST(SharedErrorTest, LocalPolicyCountsWithoutAtomics)
+{
+    LocalMessage err(std::string("local"));
+    std_::expected<void, LocalMessage> a{std_::unexpected<LocalMessage>(err)};
+    auto b = a;
+
+    EXPECT_EQ(err.use_count(), 3u);
+    EXPECT_EQ(b.error().get(), "local");
+    static_assert(std::is_same<LocalMessage::refcount_policy::count_type, std::size_t>::value,
+                  "local policy uses a plain counter");
+}
+
+TEST(SharedErrorTest, AtomicPolicyIsSafeAcrossThreads)
+{
+    auto result = fail_with("fan-out");
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back(
+            [&result]
+            {
+                for (int i = 0; i < 10'000; ++i)
+                {
+                    auto copy = result;
+                    (void)copy;
+                }
+            });
+    }
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+
+    EXPECT_EQ(result.error().use_count(), 1u);
+}
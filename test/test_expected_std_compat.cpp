@@ -0,0 +1,184 @@
+#include <expected/expected.hpp>
+#include <expected/parse.hpp>
+#include <expected/shared_error.hpp>
+#include <expected/std_bridge.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Built twice: as test_expected_std_compat against the polyfill, and as
+// test_expected_std_compat_alias with STD_EXPECTED_USE_STD, where std_::expected is
+// std::expected (if the standard library's is complete enough, see expected.hpp). Everything
+// outside the mode-specific checks must behave the same in both.
+
+
+namespace
+{
+
+struct counted
+{
+    static int copies;
+    static int moves;
+
+    int value = 0;
+
+    explicit counted(int v) : value(v) {}
+    counted(const counted& rhs) : value(rhs.value) { ++copies; }
+    counted(counted&& rhs) noexcept : value(rhs.value) { ++moves; }
+    counted& operator=(const counted&) = default;
+    counted& operator=(counted&&) = default;
+
+    static void reset()
+    {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+int counted::copies = 0;
+int counted::moves = 0;
+
+std_::expected<int, std::string> half(int v)
+{
+    if (v % 2 != 0)
+    {
+        return std_::unexpected<std::string>("odd");
+    }
+    return v / 2;
+}
+
+}  // namespace
+
+TEST(StdCompatTest, ModeMatchesConfiguration)
+{
+#if STD_EXPECTED_IS_STD
+    static_assert(std::is_same<std_::expected<int, int>, std::expected<int, int>>::value, "");
+    static_assert(std::is_same<std_::unexpected<int>, std::unexpected<int>>::value, "");
+#    if !defined(STD_EXPECTED_USE_STD)
+#        error "STD_EXPECTED_IS_STD without STD_EXPECTED_USE_STD"
+#    endif
+#elif defined(__cpp_lib_expected)
+    static_assert(!std::is_same<std_::expected<int, int>, std::expected<int, int>>::value, "");
+#endif
+    SUCCEED();
+}
+
+TEST(StdCompatTest, CommonSurfaceBehavesTheSame)
+{
+    std_::expected<int, std::string> ok = 42;
+    std_::expected<int, std::string> bad = std_::unexpected<std::string>("boom");
+
+    EXPECT_TRUE(ok.has_value());
+    EXPECT_EQ(*ok, 42);
+    EXPECT_EQ(ok.value(), 42);
+    EXPECT_EQ(bad.error(), "boom");
+    EXPECT_EQ(bad.value_or(7), 7);
+    EXPECT_EQ(ok.error_or("none"), "none");
+    EXPECT_EQ(bad, std_::unexpected<std::string>("boom"));
+    EXPECT_THROW(bad.value(), std_::bad_expected_access<std::string>);
+
+    EXPECT_EQ(*ok.and_then(half), 21);
+    EXPECT_EQ(ok.and_then(half).and_then(half).error(), "odd");
+    auto plus_one = [](int v)
+    {
+        return v + 1;
+    };
+    auto length = [](const std::string& e)
+    {
+        return e.size();
+    };
+    auto recover = [](const std::string&)
+    {
+        return half(8);
+    };
+    EXPECT_EQ(*ok.transform(plus_one), 43);
+    EXPECT_EQ(bad.transform_error(length).error(), 4u);
+    EXPECT_EQ(*bad.or_else(recover), 4);
+
+    std_::expected<void, int> done;
+    std_::expected<void, int> failed = std_::unexpected<int>(3);
+    EXPECT_TRUE(done.has_value());
+    EXPECT_EQ(failed.error(), 3);
+}
+
+TEST(StdCompatTest, LibraryHeadersWorkInBothModes)
+{
+    EXPECT_EQ(*std_::parse<int>("-12"), -12);
+    EXPECT_EQ(std_::parse<int>("1x").error().position, 1u);
+
+    auto shared = std_::make_shared_error<std::string>("shared");
+    using error_type = std_::shared_error<std::string>;
+    std_::expected<int, error_type> r = std_::unexpected<error_type>(shared);
+    EXPECT_EQ(*r.error(), "shared");
+}
+
+#if defined(__cpp_lib_expected)
+
+namespace
+{
+
+template <class R>
+concept converts_to_std = requires(R&& r) { std_::to_std(std::forward<R>(r)); };
+
+template <class R>
+concept converts_from_std = requires(R&& r) { std_::from_std(std::forward<R>(r)); };
+
+}  // namespace
+
+TEST(StdBridgeTest, RoundTripsValuesAndErrors)
+{
+    std::expected<int, std::string> s = std_::to_std(std_::expected<int, std::string>(5));
+    EXPECT_EQ(*s, 5);
+
+    auto back = std_::from_std(std::expected<int, std::string>(std::unexpected("no")));
+    static_assert(std::is_same<decltype(back), std_::expected<int, std::string>>::value, "");
+    EXPECT_EQ(back.error(), "no");
+
+    std::expected<void, int> v = std_::to_std(std_::expected<void, int>());
+    EXPECT_TRUE(v.has_value());
+    EXPECT_EQ(std_::from_std(std::expected<void, int>(std::unexpected(9))).error(), 9);
+
+    std::unexpected<int> u = std_::to_std(std_::unexpected<int>(4));
+    EXPECT_EQ(u.error(), 4);
+    EXPECT_EQ(std_::from_std(std::unexpected<int>(6)).error(), 6);
+}
+
+TEST(StdBridgeTest, ConversionsOnlyMove)
+{
+    std_::expected<counted, int> a(std_::detail::in_place, 1);
+    counted::reset();
+    std::expected<counted, int> b = std_::to_std(std::move(a));
+    EXPECT_EQ(b->value, 1);
+    EXPECT_EQ(counted::copies, 0);
+    EXPECT_EQ(counted::moves, 1);
+
+    counted::reset();
+    std_::expected<counted, int> c = std_::from_std(std::move(b));
+    EXPECT_EQ(c->value, 1);
+    EXPECT_EQ(counted::copies, 0);
+    EXPECT_EQ(counted::moves, 1);
+
+    std_::expected<int, counted> e = std_::unexpected<counted>(counted(2));
+    counted::reset();
+    std::expected<int, counted> f = std_::to_std(std::move(e));
+    EXPECT_EQ(f.error().value, 2);
+    EXPECT_EQ(counted::copies, 0);
+    EXPECT_EQ(counted::moves, 1);
+}
+
+TEST(StdBridgeTest, LvaluesAreRejected)
+{
+    using polyfill = std_::expected<int, int>;
+    using standard = std::expected<int, int>;
+    static_assert(converts_to_std<polyfill>, "");
+    static_assert(converts_from_std<standard>, "");
+    static_assert(!converts_to_std<polyfill&>, "");
+    static_assert(!converts_to_std<const polyfill&>, "");
+    static_assert(!converts_from_std<standard&>, "");
+    static_assert(!converts_to_std<std_::unexpected<int>&>, "");
+    SUCCEED();
+}
+
+#endif  // __cpp_lib_expected
@@ -0,0 +1,149 @@
+#include <expected/expected.hpp>
+#include <expected/telemetry.hpp>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+
+// Built with STD_EXPECTED_TELEMETRY (see test/CMakeLists.txt).
+
+namespace
+{
+
+struct disk_error
+{
+    int code;
+};
+
+struct parse_failure
+{
+    std::string what;
+};
+
+std::uint64_t count_of(const std::type_info& type, std_::telemetry::event kind)
+{
+    std::uint64_t total = 0;
+    for (const auto& site : std_::telemetry::snapshot())
+    {
+        if (*site.type == type && site.kind == kind)
+        {
+            total += site.count;
+        }
+    }
+    return total;
+}
+
+std_::expected<int, disk_error> read_sector(int n)
+{
+    if (n % 4 == 0)
+    {
+        return std_::unexpected<disk_error>(disk_error{n});
+    }
+    return n;
+}
+
+}  // namespace
+
+class TelemetryTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std_::telemetry::reset();
+    }
+};
+
+TEST_F(TelemetryTest, CountsConstructionsPerCallSite)
+{
+    for (int i = 0; i < 40; ++i)
+    {
+        (void)read_sector(i);
+    }
+
+    const auto sites = std_::telemetry::snapshot();
+    ASSERT_FALSE(sites.empty());
+    const auto& top = sites.front();
+    EXPECT_EQ(*top.type, typeid(disk_error));
+    EXPECT_EQ(top.kind, std_::telemetry::event::construct);
+    EXPECT_EQ(top.count, 10u);
+    EXPECT_NE(std::strstr(top.file, "test_expected_telemetry.cpp"), nullptr);
+    EXPECT_GT(top.line, 0u);
+}
+
+TEST_F(TelemetryTest, SeparatesErrorTypes)
+{
+    auto a = std_::make_unexpected(disk_error{1});
+    auto b = std_::make_unexpected(parse_failure{"eof"});
+    auto c = std_::make_unexpected(parse_failure{"eof"});
+    (void)a;
+    (void)b;
+    (void)c;
+
+    EXPECT_EQ(count_of(typeid(disk_error), std_::telemetry::event::construct), 1u);
+    EXPECT_EQ(count_of(typeid(parse_failure), std_::telemetry::event::construct), 2u);
+}
+
+TEST_F(TelemetryTest, CountsValueToErrorTransitions)
+{
+    std_::expected<int, parse_failure> value(7);
+    std_::expected<int, parse_failure> failed{std_::unexpected<parse_failure>(parse_failure{"x"})};
+    std_::expected<void, disk_error> done;
+
+    value = failed;                                      // copy assignment, value -> error
+    value = std_::unexpected<parse_failure>(parse_failure{"y"});  // error -> error
+    done = std_::unexpected<disk_error>(disk_error{4});  // void, value -> error
+
+    EXPECT_EQ(count_of(typeid(parse_failure), std_::telemetry::event::transition), 1u);
+    EXPECT_EQ(count_of(typeid(disk_error), std_::telemetry::event::transition), 1u);
+    EXPECT_EQ(count_of(typeid(parse_failure), std_::telemetry::event::construct), 2u);
+}
+
+TEST_F(TelemetryTest, TrivialCopyAssignmentStaysTrivial)
+{
+    // Hooking it would make the assignment non-trivial; the error was counted when created.
+    static_assert(std::is_trivially_copy_assignable<std_::expected<int, disk_error>>::value,
+                  "telemetry must not change triviality");
+
+    std_::expected<int, disk_error> value(7);
+    std_::expected<int, disk_error> failed{std_::unexpected<disk_error>(disk_error{2})};
+    value = failed;
+
+    EXPECT_EQ(count_of(typeid(disk_error), std_::telemetry::event::transition), 0u);
+    EXPECT_EQ(count_of(typeid(disk_error), std_::telemetry::event::construct), 1u);
+}
+
+TEST_F(TelemetryTest, MergesThreadsIncludingExitedOnes)
+{
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back(
+            []
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    (void)read_sector(0);
+                }
+            });
+    }
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+
+    EXPECT_EQ(count_of(typeid(disk_error), std_::telemetry::event::construct), 4000u);
+    EXPECT_EQ(std_::telemetry::dropped(), 0u);
+}
+
+TEST_F(TelemetryTest, ConstantEvaluationRecordsNothing)
+{
+    constexpr std_::unexpected<int> compile_time(5);
+    static_assert(compile_time.error() == 5, "still usable in constant expressions");
+
+    EXPECT_EQ(count_of(typeid(int), std_::telemetry::event::construct), 0u);
+}
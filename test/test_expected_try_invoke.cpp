@@ -0,0 +1,126 @@
+#include <expected/try_invoke.hpp>
+#include <gtest/gtest.h>
+
+#include <exception>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+
+using std_::try_invoke;
+
+namespace
+{
+
+int parse_or_throw(const std::string& text)
+{
+    return std::stoi(text);
+}
+
+struct legacy_error
+{
+    int code;
+};
+
+}  // namespace
+
+TEST(TryInvokeTest, ReturnsTheValue)
+{
+    auto n = try_invoke<std::invalid_argument>(parse_or_throw, std::string("42"));
+    using error_type = std::variant<std::invalid_argument, std::exception_ptr>;
+    static_assert(std::is_same<decltype(n), std_::expected<int, error_type>>::value, "");
+    ASSERT_TRUE(n.has_value());
+    EXPECT_EQ(*n, 42);
+}
+
+TEST(TryInvokeTest, ListedExceptionsAreCopiedWithoutExceptionPtr)
+{
+    auto bad = try_invoke<std::invalid_argument, std::out_of_range>(parse_or_throw, "abc");
+    ASSERT_FALSE(bad.has_value());
+    ASSERT_EQ(bad.error().index(), 0u);
+
+    auto big = try_invoke<std::invalid_argument, std::out_of_range>(parse_or_throw,
+                                                                    "99999999999999999999");
+    ASSERT_FALSE(big.has_value());
+    ASSERT_EQ(big.error().index(), 1u);
+    EXPECT_NE(std::string(std::get<std::out_of_range>(big.error()).what()), "");
+
+    auto custom = try_invoke<legacy_error>(
+        []() -> int
+        {
+            throw legacy_error{7};
+        });
+    EXPECT_EQ(std::get<legacy_error>(custom.error()).code, 7);
+}
+
+TEST(TryInvokeTest, FirstMatchingTypeInListOrderWins)
+{
+    auto thrower = []() -> int
+    {
+        throw std::out_of_range("range");
+    };
+
+    auto base_first = try_invoke<std::logic_error, std::out_of_range>(thrower);
+    EXPECT_EQ(base_first.error().index(), 0u);
+
+    auto derived_first = try_invoke<std::out_of_range, std::logic_error>(thrower);
+    EXPECT_EQ(derived_first.error().index(), 0u);
+    EXPECT_TRUE(std::holds_alternative<std::out_of_range>(derived_first.error()));
+}
+
+TEST(TryInvokeTest, UnknownExceptionsBecomeExceptionPtr)
+{
+    auto r = try_invoke<std::invalid_argument>(
+        []() -> int
+        {
+            throw std::runtime_error("late");
+        });
+    ASSERT_FALSE(r.has_value());
+    const auto& ptr = std::get<std::exception_ptr>(r.error());
+    ASSERT_TRUE(ptr);
+    EXPECT_THROW(std::rethrow_exception(ptr), std::runtime_error);
+
+    auto any = try_invoke(
+        []() -> int
+        {
+            throw 1;
+        });
+    EXPECT_EQ(any.error().index(), 0u);
+}
+
+TEST(TryInvokeTest, VoidAndReferenceResults)
+{
+    int calls = 0;
+    auto done = try_invoke<std::exception>(
+        [&calls]
+        {
+            ++calls;
+        });
+    EXPECT_TRUE(done.has_value());
+    EXPECT_EQ(calls, 1);
+
+    std::map<std::string, std::string> table{{"a", "alpha"}};
+    auto lookup = [&table](const std::string& key) -> const std::string&
+    {
+        return table.at(key);
+    };
+
+    auto hit = try_invoke<std::out_of_range>(lookup, "a");
+    static_assert(std::is_same<decltype(hit)::value_type, std::string>::value, "");
+    EXPECT_EQ(*hit, "alpha");
+
+    auto miss = try_invoke<std::out_of_range>(lookup, "b");
+    EXPECT_TRUE(std::holds_alternative<std::out_of_range>(miss.error()));
+}
+
+TEST(TryInvokeTest, NoexceptCallablesTakeTheFastPath)
+{
+    auto twice = [](int x) noexcept
+    {
+        return x * 2;
+    };
+    auto r = try_invoke<std::exception>(twice, 21);
+    EXPECT_EQ(*r, 42);
+}
@@ -1,3 +1,4 @@
+#include <expected/error_trace.hpp>
 #include <expected/expected.hpp>
 #include <gtest/gtest.h>
 
@@ -58,6 +59,18 @@ TEST(TypeTraitsTest, RemoveCvref)
     EXPECT_TRUE(is_same_complex);
 }
 
+TEST(TypeTraitsTest, TracedIsTransparentWhenDisabled)
+{
+#if !defined(STD_EXPECTED_ERROR_TRACE)
+    bool same = std::is_same<std_::traced<MyError>, MyError>::value;
+    EXPECT_TRUE(same);
+    EXPECT_EQ(sizeof(std_::expected<int, std_::traced<MyError>>),
+              sizeof(std_::expected<int, MyError>));
+#else
+    GTEST_SKIP() << "error tracing is enabled in this build";
+#endif
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,138 @@
+#include <expected/uring_reader.hpp>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+
+class UringReaderTest : public ::testing::TestWithParam<bool>
+{
+protected:
+    void SetUp() override
+    {
+        char name[] = "/tmp/std_expected_uring_XXXXXX";
+        fd_ = ::mkstemp(name);
+        ASSERT_GE(fd_, 0);
+        path_ = name;
+        for (int i = 0; i < 64 * 1024; ++i)
+        {
+            contents_.push_back(static_cast<char>('a' + i % 26));
+        }
+        ASSERT_EQ(::write(fd_, contents_.data(), contents_.size()),
+                  static_cast<ssize_t>(contents_.size()));
+    }
+
+    void TearDown() override
+    {
+        ::close(fd_);
+        std::remove(path_.c_str());
+    }
+
+    std_::uring_reader make_reader(unsigned queue_depth = 8)
+    {
+        std_::uring_options options;
+        options.queue_depth = queue_depth;
+        options.force_fallback = GetParam();
+        options.pool_threads = 3;
+        auto reader = std_::uring_reader::create(options);
+        EXPECT_TRUE(reader.has_value());
+        return std::move(*reader);
+    }
+
+    int fd_ = -1;
+    std::string path_;
+    std::string contents_;
+};
+
+TEST_P(UringReaderTest, CompletionsMatchRequestsInOrder)
+{
+    auto reader = make_reader();
+
+    constexpr std::size_t count = 100;  // more than the queue depth
+    std::vector<std::vector<std::byte>> buffers(count, std::vector<std::byte>(512));
+    std::vector<std_::read_request> requests;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        requests.push_back({fd_, i * 613, buffers[i]});
+    }
+    std::vector<std_::read_completion> completions(count);
+
+    ASSERT_TRUE(reader.read_batch(requests, completions).has_value());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ASSERT_TRUE(completions[i].has_value()) << i;
+        EXPECT_EQ(*completions[i], 512u);
+        EXPECT_EQ(std::memcmp(buffers[i].data(), contents_.data() + i * 613, 512), 0) << i;
+    }
+}
+
+TEST_P(UringReaderTest, FailuresStayInTheirCompletion)
+{
+    auto reader = make_reader();
+
+    std::vector<std::byte> a(100), b(100), c(100);
+    const std::uint64_t near_end = contents_.size() - 40;
+    const std_::read_request requests[] = {
+        {fd_, 0, a},
+        {-1, 0, b},         // bad descriptor
+        {fd_, near_end, c}  // short read at the end of the file
+    };
+    std_::read_completion completions[3];
+
+    ASSERT_TRUE(reader.read_batch(requests, completions).has_value());
+    EXPECT_EQ(*completions[0], 100u);
+    ASSERT_FALSE(completions[1].has_value());
+    EXPECT_EQ(completions[1].error(), std_::io_error(std_::io_op::read, EBADF));
+    EXPECT_EQ(*completions[2], 40u);
+}
+
+TEST_P(UringReaderTest, ReusedAcrossBatches)
+{
+    auto reader = make_reader(4);
+
+    std::vector<std::byte> buf(26);
+    for (int round = 0; round < 50; ++round)
+    {
+        const std_::read_request request{fd_, static_cast<std::uint64_t>(round) * 26, buf};
+        std_::read_completion completion;
+        ASSERT_TRUE(reader.read_batch({&request, 1}, {&completion, 1}).has_value());
+        ASSERT_EQ(*completion, 26u);
+        EXPECT_EQ(static_cast<char>(buf[0]), 'a');
+    }
+
+    EXPECT_TRUE(reader.read_batch({}, {}).has_value());
+}
+
+TEST_P(UringReaderTest, RejectsTooFewCompletions)
+{
+    auto reader = make_reader();
+
+    std::vector<std::byte> buf(8);
+    const std_::read_request requests[] = {{fd_, 0, buf}, {fd_, 8, buf}};
+    std_::read_completion completion;
+
+    auto done = reader.read_batch(requests, {&completion, 1});
+    ASSERT_FALSE(done.has_value());
+    EXPECT_EQ(done.error().value(), EINVAL);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, UringReaderTest, ::testing::Values(false, true),
+                         [](const ::testing::TestParamInfo<bool>& param_info)
+                         {
+                             return param_info.param ? "PreadPool" : "Default";
+                         });
+
+TEST(UringReaderFallbackTest, ForcedFallbackNeverUsesTheRing)
+{
+    std_::uring_options options;
+    options.force_fallback = true;
+    auto reader = std_::uring_reader::create(options);
+    ASSERT_TRUE(reader.has_value());
+    EXPECT_FALSE(reader->uses_io_uring());
+}
@@ -0,0 +1,206 @@
+#include <expected/wire.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace wire = std_::wire;
+
+struct io_status
+{
+    std::int32_t code;
+    std::uint16_t retry_after;
+};
+
+struct sample
+{
+    double value;
+    std::uint64_t timestamp;
+};
+
+using Result = std_::expected<sample, io_status>;
+
+std::vector<Result> mixed_results(std::size_t n)
+{
+    std::vector<Result> out;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (i % 3 == 1 || i % 7 == 0)
+        {
+            out.push_back(std_::unexpected<io_status>(io_status{-static_cast<int>(i), 5}));
+        }
+        else
+        {
+            out.push_back(sample{static_cast<double>(i) * 0.5, i});
+        }
+    }
+    return out;
+}
+
+TEST(WireTest, SingleResultRoundTrips)
+{
+    std::byte buf[wire::max_encoded_size<sample, io_status>];
+
+    Result ok(sample{1.5, 42});
+    auto n = wire::encode(ok, buf);
+    ASSERT_TRUE(n.has_value());
+    EXPECT_EQ(*n, 1 + sizeof(sample));
+    EXPECT_EQ(buf[0], std::byte{1});
+
+    auto back = wire::decode<sample, io_status>(std::span<const std::byte>(buf, *n));
+    ASSERT_TRUE(back.has_value());
+    ASSERT_TRUE(back->has_value());
+    EXPECT_EQ((*back)->value, 1.5);
+    EXPECT_EQ((*back)->timestamp, 42u);
+
+    Result err(std_::unexpected<io_status>(io_status{-9, 3}));
+    n = wire::encode(err, buf);
+    ASSERT_TRUE(n.has_value());
+    EXPECT_EQ(*n, 1 + sizeof(io_status));
+
+    back = wire::decode<sample, io_status>(std::span<const std::byte>(buf, *n));
+    ASSERT_TRUE(back.has_value());
+    ASSERT_FALSE(back->has_value());
+    EXPECT_EQ(back->error().code, -9);
+    EXPECT_EQ(back->error().retry_after, 3u);
+}
+
+TEST(WireTest, SingleResultRejectsShortAndUnknownInput)
+{
+    std::byte buf[wire::max_encoded_size<sample, io_status>];
+    Result ok(sample{2.0, 7});
+
+    EXPECT_EQ(wire::encode(ok, std::span<std::byte>(buf, 4)).error(), wire::wire_error::truncated);
+
+    ASSERT_TRUE(wire::encode(ok, buf).has_value());
+    auto cut = wire::decode<sample, io_status>(std::span<const std::byte>(buf, sizeof(sample)));
+    EXPECT_EQ(cut.error(), wire::wire_error::truncated);
+
+    buf[0] = std::byte{7};
+    EXPECT_EQ((wire::decode<sample, io_status>(buf).error()), wire::wire_error::bad_tag);
+    EXPECT_EQ((wire::decode<sample, io_status>({}).error()), wire::wire_error::truncated);
+}
+
+TEST(WireTest, BatchViewReadsInPlace)
+{
+    const auto items = mixed_results(200);
+    const auto bytes = wire::encode_batch<sample, io_status>(items).value();
+    ASSERT_EQ(bytes.size(), (wire::encoded_batch_size<sample, io_status>(items)));
+
+    auto view = wire::batch_view<sample, io_status>::parse(bytes);
+    ASSERT_TRUE(view.has_value());
+    ASSERT_EQ(view->size(), items.size());
+
+    std::size_t values = 0;
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        auto r = (*view)[i];
+        ASSERT_EQ(r.has_value(), items[i].has_value()) << i;
+        EXPECT_EQ(view->has_value(i), items[i].has_value());
+        if (r)
+        {
+            EXPECT_EQ(r->get().timestamp, items[i]->timestamp);
+            // The reference points into the buffer, not at a copy.
+            EXPECT_EQ(static_cast<const void*>(&r->get()),
+                      static_cast<const void*>(&view->values()[values]));
+            ++values;
+        }
+        else
+        {
+            EXPECT_EQ(r.error().get().code, items[i].error().code);
+        }
+    }
+    EXPECT_EQ(view->values().size(), values);
+    EXPECT_EQ(view->errors().size(), items.size() - values);
+}
+
+TEST(WireTest, BatchBlocksAreContiguousAndAligned)
+{
+    const auto items = mixed_results(130);
+    const auto bytes = wire::encode_batch<sample, io_status>(items).value();
+    auto view = wire::batch_view<sample, io_status>::parse(bytes);
+    ASSERT_TRUE(view.has_value());
+
+    auto values = view->values();
+    auto errors = view->errors();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values.data()) % alignof(sample), 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(errors.data()) % alignof(io_status), 0u);
+
+    // Item order is preserved within each block.
+    for (std::size_t i = 1; i < values.size(); ++i)
+    {
+        EXPECT_LT(values[i - 1].timestamp, values[i].timestamp);
+    }
+    for (std::size_t i = 1; i < errors.size(); ++i)
+    {
+        EXPECT_GT(errors[i - 1].code, errors[i].code);
+    }
+}
+
+TEST(WireTest, EmptyAndAllErrorBatches)
+{
+    const std::vector<Result> none;
+    const auto empty_bytes = wire::encode_batch<sample, io_status>(none).value();
+    EXPECT_EQ(empty_bytes.size(), sizeof(wire::batch_header));
+    auto empty = wire::batch_view<sample, io_status>::parse(empty_bytes);
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_TRUE(empty->empty());
+
+    std::vector<Result> failures(64, Result(std_::unexpected<io_status>(io_status{1, 0})));
+    const auto bytes = wire::encode_batch<sample, io_status>(failures).value();
+    auto view = wire::batch_view<sample, io_status>::parse(bytes);
+    ASSERT_TRUE(view.has_value());
+    EXPECT_TRUE(view->values().empty());
+    EXPECT_EQ(view->errors().size(), 64u);
+    EXPECT_FALSE((*view)[63].has_value());
+}
+
+TEST(WireTest, ParseRejectsMalformedBatches)
+{
+    const auto items = mixed_results(100);
+    const auto good = wire::encode_batch<sample, io_status>(items).value();
+    using View = wire::batch_view<sample, io_status>;
+
+    EXPECT_EQ(View::parse(std::span<const std::byte>(good.data(), 16)).error(),
+              wire::wire_error::truncated);
+    EXPECT_EQ(View::parse(std::span<const std::byte>(good.data(), good.size() - 1)).error(),
+              wire::wire_error::truncated);
+
+    auto bad_magic = good;
+    bad_magic[0] = std::byte{0};
+    EXPECT_EQ(View::parse(bad_magic).error(), wire::wire_error::bad_magic);
+
+    EXPECT_EQ((wire::batch_view<sample, std::uint64_t>::parse(good).error()),
+              wire::wire_error::type_mismatch);
+
+    // Flip a bitmap bit: the rank directory no longer matches.
+    auto bad_bitmap = good;
+    bad_bitmap[sizeof(wire::batch_header)] ^= std::byte{0x02};
+    EXPECT_EQ(View::parse(bad_bitmap).error(), wire::wire_error::corrupt);
+
+    std::vector<std::byte> shifted(good.size() + 1);
+    std::copy(good.begin(), good.end(), shifted.begin() + 1);
+    EXPECT_EQ(View::parse(std::span<const std::byte>(shifted.data() + 1, good.size())).error(),
+              wire::wire_error::misaligned);
+}
+
+TEST(WireTest, EncodeBatchChecksTheOutputBuffer)
+{
+    const auto items = mixed_results(10);
+    const std::size_t size = wire::encoded_batch_size<sample, io_status>(items);
+
+    std::vector<std::uint64_t> storage(size / 8 + 1);
+    std::span<std::byte> out(reinterpret_cast<std::byte*>(storage.data()), size);
+    auto written = wire::encode_batch<sample, io_status>(items, out);
+    ASSERT_TRUE(written.has_value());
+    EXPECT_EQ(*written, size);
+
+    EXPECT_EQ((wire::encode_batch<sample, io_status>(items, out.first(size - 1)).error()),
+              wire::wire_error::truncated);
+    EXPECT_EQ((wire::encode_batch<sample, io_status>(items, out.subspan(4)).error()),
+              wire::wire_error::misaligned);
+}